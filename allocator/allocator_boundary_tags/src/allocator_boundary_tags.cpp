@@ -58,7 +58,7 @@ allocator_boundary_tags::allocator_boundary_tags(
     size_t size)
 {
     size_t total_size = size + sizeof(block_metadata);
-    debug_with_guard(std::format("[*] allocating {} bytes", total_size));
+    DEBUG_FIELDS_WITH_GUARD("[*] allocating", {"bytes", total_size});
 
     auto& metadata = get_allocator_metadata();
 
@@ -134,12 +134,11 @@ allocator_boundary_tags::allocator_boundary_tags(
         free_block->prev_->next_ = free_block;
     }
 
-    debug_with_guard(std::format(
-        "[+] allocated {} bytes at {:p}",
-        total_size, static_cast<void*>(free_block + 1)));
+    DEBUG_FIELDS_WITH_GUARD("[+] allocated",
+        {"bytes", total_size}, {"block", static_cast<void*>(free_block + 1)});
     information_with_guard(std::format(
         "[*] available memory: {}", get_available_memory()));
-    debug_with_guard(print_blocks());
+    DEBUG_WITH_GUARD(print_blocks());
 
     return free_block + 1;
 }
@@ -147,7 +146,7 @@ allocator_boundary_tags::allocator_boundary_tags(
 void allocator_boundary_tags::do_deallocate_sm(
     void *at)
 {
-    debug_with_guard(std::format("[*] deallocating block {:p}", at));
+    DEBUG_FIELDS_WITH_GUARD("[*] deallocating", {"block", at});
 
     auto& metadata = get_allocator_metadata();
 
@@ -163,7 +162,7 @@ void allocator_boundary_tags::do_deallocate_sm(
         throw std::logic_error("unknown block");
     }
 
-    debug_with_guard(get_dump(static_cast<char*>(at), block->block_size_));
+    DEBUG_WITH_GUARD(get_dump(static_cast<char*>(at), block->block_size_));
 
     if (block->prev_ == _trusted_memory)
     {
@@ -179,10 +178,10 @@ void allocator_boundary_tags::do_deallocate_sm(
         block->next_->prev_ = block->prev_;
     }
 
-    debug_with_guard("[+] block deallocated successfully");
+    DEBUG_WITH_GUARD("[+] block deallocated successfully");
     information_with_guard(std::format(
         "[*] available memory: {}", get_available_memory()));
-    debug_with_guard(print_blocks());
+    DEBUG_WITH_GUARD(print_blocks());
 }
 
 inline void allocator_boundary_tags::set_fit_mode(
@@ -203,8 +202,7 @@ inline void allocator_boundary_tags::set_fit_mode(
             break;
     }
 
-    debug_with_guard(std::format(
-        "[*] setting fit mode: {}", fit_mode_string));
+    DEBUG_FIELDS_WITH_GUARD("[*] setting fit mode", {"mode", fit_mode_string});
 
     auto& metadata = get_allocator_metadata();
     std::lock_guard lock(metadata.mutex_);
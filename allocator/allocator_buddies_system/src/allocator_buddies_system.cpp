@@ -68,7 +68,7 @@ allocator_buddies_system::allocator_buddies_system(
 [[nodiscard]] void *allocator_buddies_system::do_allocate_sm(
     size_t size)
 {
-    debug_with_guard("[>] entering allocator_buddies_system::do_allocate_sm");
+    DEBUG_WITH_GUARD("[>] entering allocator_buddies_system::do_allocate_sm");
 
     auto metadata = reinterpret_cast<allocator_metadata *>(_trusted_memory);
     std::lock_guard<std::mutex> lock(metadata->mutex);
@@ -76,7 +76,7 @@ allocator_buddies_system::allocator_buddies_system(
     size_t size_with_metadata = size + sizeof(occupied_block_metadata_size);
     block_metadata *block = nullptr;
 
-    debug_with_guard(std::format("[*] allocating {} bytes", size_with_metadata));
+    DEBUG_FIELDS_WITH_GUARD("[*] allocating", {"bytes", size_with_metadata});
 
     switch (metadata->fit_mode)
     {
@@ -122,20 +122,20 @@ allocator_buddies_system::allocator_buddies_system(
 
     information_with_guard(std::format("[+] allocated {} bytes at {}, available memory: {} bytes",
                                        size_with_metadata, allocated_block, available_memory()));
-    debug_with_guard(std::format("[*] current blocks: \n{}", print_blocks()));
-    debug_with_guard("[<] leaving allocator_buddies_system::do_allocate_sm");
+    DEBUG_WITH_GUARD(std::format("[*] current blocks: \n{}", print_blocks()));
+    DEBUG_WITH_GUARD("[<] leaving allocator_buddies_system::do_allocate_sm");
 
     return allocated_block;
 }
 
 void allocator_buddies_system::do_deallocate_sm(void *at)
 {
-    debug_with_guard("[>] entering allocator_buddies_system::do_deallocate_sm");
+    DEBUG_WITH_GUARD("[>] entering allocator_buddies_system::do_deallocate_sm");
 
     auto metadata = reinterpret_cast<allocator_metadata *>(_trusted_memory);
     std::lock_guard<std::mutex> lock(metadata->mutex);
 
-    debug_with_guard(std::format("[*] deallocating block at {}", at));
+    DEBUG_FIELDS_WITH_GUARD("[*] deallocating", {"block", at});
 
     auto block = reinterpret_cast<block_metadata *>(static_cast<std::byte *>(at) - occupied_block_metadata_size);
 
@@ -167,8 +167,8 @@ void allocator_buddies_system::do_deallocate_sm(void *at)
 
     information_with_guard(std::format("[+] deallocated block at {}, available memory: {} bytes",
                                        at, available_memory()));
-    debug_with_guard(std::format("[*] current blocks: \n{}", print_blocks()));
-    debug_with_guard("[<] leaving allocator_buddies_system::do_deallocate_sm");
+    DEBUG_WITH_GUARD(std::format("[*] current blocks: \n{}", print_blocks()));
+    DEBUG_WITH_GUARD("[<] leaving allocator_buddies_system::do_deallocate_sm");
 }
 
 bool allocator_buddies_system::do_is_equal(const std::pmr::memory_resource &other) const noexcept
@@ -179,7 +179,7 @@ bool allocator_buddies_system::do_is_equal(const std::pmr::memory_resource &othe
 inline void allocator_buddies_system::set_fit_mode(
     allocator_with_fit_mode::fit_mode mode)
 {
-    debug_with_guard("[>] entering allocator_buddies_system::set_fit_mode");
+    DEBUG_WITH_GUARD("[>] entering allocator_buddies_system::set_fit_mode");
 
     auto metadata = reinterpret_cast<allocator_metadata *>(_trusted_memory);
     std::lock_guard<std::mutex> lock(metadata->mutex);
@@ -200,12 +200,12 @@ inline void allocator_buddies_system::set_fit_mode(
         default:
             throw std::invalid_argument("invalid fit mode");
         }
-        debug_with_guard(std::format("[*] changing fit mode to {}", mode_string));
+        DEBUG_FIELDS_WITH_GUARD("[*] changing fit mode", {"mode", mode_string});
     }
 
     metadata->fit_mode = mode;
 
-    debug_with_guard("[<] leaving allocator_buddies_system::set_fit_mode");
+    DEBUG_WITH_GUARD("[<] leaving allocator_buddies_system::set_fit_mode");
 }
 
 std::vector<allocator_test_utils::block_info> allocator_buddies_system::get_blocks_info() const noexcept
@@ -10,7 +10,7 @@ allocator_global_heap::allocator_global_heap(
 [[nodiscard]] void *allocator_global_heap::do_allocate_sm(
     size_t size)
 {
-    debug_with_guard(std::format("[*] do_allocate_sm({})", size));
+    DEBUG_FIELDS_WITH_GUARD("[*] do_allocate_sm", {"size", size});
 
     void* mem;
 
@@ -23,7 +23,7 @@ allocator_global_heap::allocator_global_heap(
         throw;
     }
 
-    debug_with_guard(std::format("[+] allocated {} bytes at {:p}", size, mem));
+    DEBUG_FIELDS_WITH_GUARD("[+] allocated", {"bytes", size}, {"block", mem});
 
     return mem;
 }
@@ -33,7 +33,7 @@ void allocator_global_heap::do_deallocate_sm(
 {
     if (at)
     {
-        debug_with_guard(std::format("[*] freeing at {:p}", at));
+        DEBUG_FIELDS_WITH_GUARD("[*] freeing", {"block", at});
         ::operator delete(at);
     }
 }
@@ -54,9 +54,9 @@ allocator_global_heap::~allocator_global_heap()
 allocator_global_heap::allocator_global_heap(const allocator_global_heap &other)
     : _logger(other._logger)
 {
-    trace_with_guard(
+    TRACE_WITH_GUARD(
         "[>] allocator_global_heap::allocator_global_heap(const allocator_global_heap &other)");
-    trace_with_guard(
+    TRACE_WITH_GUARD(
         "[<] allocator_global_heap::allocator_global_heap(const allocator_global_heap &other)");
 }
 
@@ -66,10 +66,10 @@ allocator_global_heap &allocator_global_heap::operator=(const allocator_global_h
     {
         return *this;
     }
-    trace_with_guard(
+    TRACE_WITH_GUARD(
         "[>] allocator_global_heap &allocator_global_heap::operator=(const allocator_global_heap &other)");
     _logger = other._logger;
-    trace_with_guard(
+    TRACE_WITH_GUARD(
         "[<] allocator_global_heap &allocator_global_heap::operator=(const allocator_global_heap &other)");
     return *this;
 }
@@ -81,25 +81,25 @@ bool allocator_global_heap::do_is_equal(const std::pmr::memory_resource &other)
 
 allocator_global_heap::allocator_global_heap(allocator_global_heap &&other) noexcept
 {
-    trace_with_guard(
+    TRACE_WITH_GUARD(
         "[>] allocator_global_heap::allocator_global_heap(allocator_global_heap &&other) noexcept");
     if (this != &other)
     {
         _logger = other._logger;
     }
-    trace_with_guard(
+    TRACE_WITH_GUARD(
         "[<] allocator_global_heap::allocator_global_heap(allocator_global_heap &&other) noexcept");
 }
 
 allocator_global_heap &allocator_global_heap::operator=(allocator_global_heap &&other) noexcept
 {
-    trace_with_guard(
+    TRACE_WITH_GUARD(
         "[>] allocator_global_heap &allocator_global_heap::operator=(allocator_global_heap &&other) noexcept");
     if (this != &other)
     {
         _logger = other._logger;
     }
-    trace_with_guard(
+    TRACE_WITH_GUARD(
         "[<] allocator_global_heap &allocator_global_heap::operator=(allocator_global_heap &&other) noexcept");
     return *this;
 }
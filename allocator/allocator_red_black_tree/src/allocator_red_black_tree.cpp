@@ -76,12 +76,12 @@ bool allocator_red_black_tree::do_is_equal(const std::pmr::memory_resource &othe
 [[nodiscard]] void *allocator_red_black_tree::do_allocate_sm(
     size_t size)
 {
-    debug_with_guard("[>] entering allocator_red_black_tree::do_allocate_sm");
+    DEBUG_WITH_GUARD("[>] entering allocator_red_black_tree::do_allocate_sm");
 
     allocator_metadata* alloc = get_metadata();
     std::lock_guard guard(alloc->mutex_);
 
-    debug_with_guard(std::format("[*] allocating {} bytes", size));
+    DEBUG_FIELDS_WITH_GUARD("[*] allocating", {"bytes", size});
     free_block_metadata* taken_block = nullptr;
 
     switch (alloc->fit_mode_)
@@ -138,8 +138,8 @@ bool allocator_red_black_tree::do_is_equal(const std::pmr::memory_resource &othe
 
     information_with_guard(std::format("[+] allocated {} bytes at {}, available memory: {} bytes",
                                        size, allocated_block, available_memory()));
-    debug_with_guard(std::format("[*] current blocks: \n{}", print_blocks()));
-    debug_with_guard("[<] leaving allocator_red_black_tree::do_allocate_sm");
+    DEBUG_WITH_GUARD(std::format("[*] current blocks: \n{}", print_blocks()));
+    DEBUG_WITH_GUARD("[<] leaving allocator_red_black_tree::do_allocate_sm");
 
     return allocated_block;
 }
@@ -151,7 +151,7 @@ void allocator_red_black_tree::do_deallocate_sm(
     allocator_metadata* alloc = get_metadata();
     std::lock_guard guard(alloc->mutex_);
 
-    debug_with_guard(std::format("[*] deallocating block at {}", at));
+    DEBUG_FIELDS_WITH_GUARD("[*] deallocating", {"block", at});
 
     auto* block = reinterpret_cast<block_metadata*>(
         static_cast<std::byte*>(at) - sizeof(block_metadata));
@@ -193,8 +193,8 @@ void allocator_red_black_tree::do_deallocate_sm(
 
     information_with_guard(std::format("[+] deallocated block at {}, available memory: {} bytes",
                                        at, available_memory()));
-    debug_with_guard(std::format("[*] current blocks: \n{}", print_blocks()));
-    debug_with_guard("[<] leaving allocator_red_black_tree::do_deallocate_sm");
+    DEBUG_WITH_GUARD(std::format("[*] current blocks: \n{}", print_blocks()));
+    DEBUG_WITH_GUARD("[<] leaving allocator_red_black_tree::do_deallocate_sm");
 }
 
 void allocator_red_black_tree::set_fit_mode(allocator_with_fit_mode::fit_mode mode)
@@ -90,27 +90,17 @@ void *allocator_sorted_list::get_next_ptr(void *block_header) {
 }
 
 void allocator_sorted_list::set_next_ptr(void *block_header, void *new_ptr) {
-    auto l = get_logger();
-    if (l != nullptr){
-        l->trace("allocator_sorted_list::set_next_ptr started\n");
-    }
+    TRACE_WITH_GUARD("allocator_sorted_list::set_next_ptr started\n");
     auto ptr = reinterpret_cast<void **>(static_cast<uint8_t *>(block_header) + sizeof(size_t));
     *ptr = new_ptr;
-    if (l != nullptr){
-        l->trace("allocator_sorted_list::set_next_ptr finished\n");
-    }
+    TRACE_WITH_GUARD("allocator_sorted_list::set_next_ptr finished\n");
 }
 
 void allocator_sorted_list::set_size_in_block_metadata(void *block_header, size_t new_size) {
-    auto l = get_logger();
-    if (l != nullptr){
-        l->trace("allocator_sorted_list::set_size_in_block_metadata started\n");
-    }
+    TRACE_WITH_GUARD("allocator_sorted_list::set_size_in_block_metadata started\n");
     auto ptr = reinterpret_cast<size_t *>(static_cast<uint8_t *>(block_header));
     *ptr = new_size;
-    if (l != nullptr){
-        l->trace("allocator_sorted_list::set_size_in_block_metadata finished\n");
-    }
+    TRACE_WITH_GUARD("allocator_sorted_list::set_size_in_block_metadata finished\n");
 }
 
 size_t allocator_sorted_list::get_size(void *block_header) {
@@ -129,9 +119,7 @@ size_t allocator_sorted_list::get_free_memory_count(){
 void *allocator_sorted_list::do_allocate_sm(size_t size) {
     std::lock_guard<std::mutex> lock(get_mutex());
     logger* l = get_logger();
-    if (l != nullptr){
-        l->debug("do_allocate_sm started\n");
-    }
+    DEBUG_WITH_GUARD("do_allocate_sm started\n");
 
     void *prev_free_block = nullptr;
     void *result_block = nullptr;
@@ -194,21 +182,23 @@ void *allocator_sorted_list::do_allocate_sm(size_t size) {
         l->information("Memory left: ");
         size_t count = get_free_memory_count();
         l->information(std::to_string(count) + "\n");
-        auto blocks = get_blocks_info();
-        for(auto item: blocks){
-            l->debug(std::to_string(item.block_size) + " " + std::to_string(item.is_block_occupied) + "\n");
+    }
+    if constexpr (LOGGER_COMPILED_IN(debug)) {
+        if (l != nullptr){
+            auto blocks = get_blocks_info();
+            for(auto item: blocks){
+                l->debug(std::to_string(item.block_size) + " " + std::to_string(item.is_block_occupied) + "\n");
+            }
         }
-        l->debug("do_allocate_sm finished\n");
     }
+    DEBUG_WITH_GUARD("do_allocate_sm finished\n");
     set_next_ptr(result_block, _trusted_memory);
     return reinterpret_cast<void *>(static_cast<uint8_t *>(result_block) + block_metadata_size);
 }
 
 void allocator_sorted_list::do_deallocate_sm(void *at) {
     logger* l = get_logger();
-    if (l != nullptr){
-        l->debug("do_deallocate_sm started\n");
-    }
+    DEBUG_WITH_GUARD("do_deallocate_sm started\n");
     std::lock_guard<std::mutex> lock(get_mutex());
 
     uint8_t *block_header = static_cast<uint8_t *>(at) - block_metadata_size;
@@ -261,19 +251,20 @@ void allocator_sorted_list::do_deallocate_sm(void *at) {
         l->information("Memory left: ");
         size_t count = get_free_memory_count();
         l->information(std::to_string(count));
-        auto blocks = get_blocks_info();
-        for(auto item: blocks){
-            l->debug(std::to_string(item.block_size) + " " + std::to_string(item.is_block_occupied) + "\n");
+    }
+    if constexpr (LOGGER_COMPILED_IN(debug)) {
+        if (l != nullptr){
+            auto blocks = get_blocks_info();
+            for(auto item: blocks){
+                l->debug(std::to_string(item.block_size) + " " + std::to_string(item.is_block_occupied) + "\n");
+            }
         }
-        l->debug("do_deallocate_sm started finished\n");
     }
+    DEBUG_WITH_GUARD("do_deallocate_sm started finished\n");
 }
 
 bool allocator_sorted_list::try_merge(uint8_t *left, uint8_t *right){
-    auto l = get_logger();
-    if (l != nullptr){
-        l->trace("allocator_sorted_list::try_merge started\n");
-    }
+    TRACE_WITH_GUARD("allocator_sorted_list::try_merge started\n");
     if (left == nullptr || right == nullptr) {
         return false;
     }
@@ -285,35 +276,23 @@ bool allocator_sorted_list::try_merge(uint8_t *left, uint8_t *right){
         set_next_ptr(left, get_next_ptr(right));
         return true;
     }
-    if (l != nullptr){
-        l->trace("allocator_sorted_list::try_merge finished\n");
-    }
+    TRACE_WITH_GUARD("allocator_sorted_list::try_merge finished\n");
     return false;
 }
 
 bool allocator_sorted_list::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
-    logger* l = get_logger();
-    if (l != nullptr){
-        l->debug("allocator_sorted_list::do_is_equal started\n");
-    }
+    DEBUG_WITH_GUARD("allocator_sorted_list::do_is_equal started\n");
     auto res = *this == other;
-    if (l != nullptr){
-        l->debug("allocator_sorted_list::do_is_equal finished\n");
-    }
+    DEBUG_WITH_GUARD("allocator_sorted_list::do_is_equal finished\n");
     return res;
 }
 
 void allocator_sorted_list::set_fit_mode(allocator_with_fit_mode::fit_mode mode) {
-    logger* l = get_logger();
-    if (l != nullptr){
-        l->debug("allocator_sorted_list::set_fit_mode started\n");
-    }
+    DEBUG_WITH_GUARD("allocator_sorted_list::set_fit_mode started\n");
     std::lock_guard<std::mutex> lock(get_mutex());
     *reinterpret_cast<fit_mode *>(static_cast<uint8_t *>(_trusted_memory) + sizeof(logger *) +
                                   sizeof(std::pmr::memory_resource *)) = mode;
-    if (l != nullptr){
-        l->debug("allocator_sorted_list::set_fit_mode finished\n");
-    }
+    DEBUG_WITH_GUARD("allocator_sorted_list::set_fit_mode finished\n");
 }
 
 std::vector<allocator_test_utils::block_info> allocator_sorted_list::get_blocks_info() const noexcept {
@@ -321,17 +300,12 @@ std::vector<allocator_test_utils::block_info> allocator_sorted_list::get_blocks_
 }
 
 std::vector<allocator_test_utils::block_info> allocator_sorted_list::get_blocks_info_inner() const {
-    logger* l = get_logger();
-    if (l != nullptr){
-        l->debug("allocator_sorted_list::get_blocks_info_inner started\n");
-    }
+    DEBUG_WITH_GUARD("allocator_sorted_list::get_blocks_info_inner started\n");
     std::vector<block_info> info;
     for (auto it = begin(); it != end(); ++it)
         info.emplace_back(it.size(), it.occupied());
 
-    if (l != nullptr){
-        l->debug("allocator_sorted_list::get_blocks_info_inner finished\n");
-    }
+    DEBUG_WITH_GUARD("allocator_sorted_list::get_blocks_info_inner finished\n");
     return info;
 }
 
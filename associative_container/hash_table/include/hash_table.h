@@ -20,6 +20,15 @@ concept search_ds_for = std::same_as<typename T::value_type, std::pair<const tke
                 {t.erase(key)} -> std::forward_iterator;
             };
 
+// A lookup key other than tkey needs a transparent hash and buckets that look it up themselves,
+// e.g. std::map with std::less<>
+template<typename K, typename hash, typename sds>
+concept transparent_lookup_for = transparent_hash<hash, K> &&
+                                 requires(const sds& bucket, const K& key)
+                                 {
+                                     bucket.find(key);
+                                 };
+
 template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds = std::map<tkey, tvalue, std::less<tkey>, pp_allocator<std::pair<const tkey, tvalue>>>, typename hash = std::hash<tkey>>
 class hash_table final
 {
@@ -197,6 +206,25 @@ public:
 
     bool contains(const tkey& key) const;
 
+    /*
+     * Same lookups by any type the hash and the buckets take, only for a hash declaring is_transparent
+     */
+
+    template<typename K> requires transparent_lookup_for<K, hash, sds>
+    tvalue& at(const K& key);
+
+    template<typename K> requires transparent_lookup_for<K, hash, sds>
+    const tvalue& at(const K& key) const;
+
+    template<typename K> requires transparent_lookup_for<K, hash, sds>
+    iterator find(const K& key);
+
+    template<typename K> requires transparent_lookup_for<K, hash, sds>
+    const_iterator find(const K& key) const;
+
+    template<typename K> requires transparent_lookup_for<K, hash, sds>
+    bool contains(const K& key) const;
+
     // endregion lookup declaration
 
     // region modifiers declaration
@@ -437,6 +465,20 @@ tvalue& hash_table<tkey, tvalue, sds, hash>::operator[](tkey&& key)
     throw not_implemented("template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash> tvalue& hash_table<tkey, tvalue, sds, hash>::operator[](tkey&&)", "your code should be here...");
 }
 
+template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash>
+template<typename K> requires transparent_lookup_for<K, hash, sds>
+tvalue& hash_table<tkey, tvalue, sds, hash>::at(const K& key)
+{
+    throw not_implemented("template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash> template<typename K> requires transparent_lookup_for<K, hash, sds> tvalue& hash_table<tkey, tvalue, sds, hash>::at(const K&)", "your code should be here...");
+}
+
+template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash>
+template<typename K> requires transparent_lookup_for<K, hash, sds>
+const tvalue& hash_table<tkey, tvalue, sds, hash>::at(const K& key) const
+{
+    throw not_implemented("template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash> template<typename K> requires transparent_lookup_for<K, hash, sds> const tvalue& hash_table<tkey, tvalue, sds, hash>::at(const K&) const", "your code should be here...");
+}
+
 // endregion element access implementation
 
 // region iterator begins implementation
@@ -548,6 +590,27 @@ bool hash_table<tkey, tvalue, sds, hash>::contains(const tkey& key) const
     throw not_implemented("template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash> bool hash_table<tkey, tvalue, sds, hash>::contains(const tkey& ) const", "your code should be here...");
 }
 
+template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash>
+template<typename K> requires transparent_lookup_for<K, hash, sds>
+typename hash_table<tkey, tvalue, sds, hash>::iterator hash_table<tkey, tvalue, sds, hash>::find(const K& key)
+{
+    throw not_implemented("template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash> template<typename K> requires transparent_lookup_for<K, hash, sds> typename hash_table<tkey, tvalue, sds, hash>::iterator hash_table<tkey, tvalue, sds, hash>::find(const K&)", "your code should be here...");
+}
+
+template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash>
+template<typename K> requires transparent_lookup_for<K, hash, sds>
+typename hash_table<tkey, tvalue, sds, hash>::const_iterator hash_table<tkey, tvalue, sds, hash>::find(const K& key) const
+{
+    throw not_implemented("template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash> template<typename K> requires transparent_lookup_for<K, hash, sds> typename hash_table<tkey, tvalue, sds, hash>::const_iterator hash_table<tkey, tvalue, sds, hash>::find(const K&) const", "your code should be here...");
+}
+
+template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash>
+template<typename K> requires transparent_lookup_for<K, hash, sds>
+bool hash_table<tkey, tvalue, sds, hash>::contains(const K& key) const
+{
+    throw not_implemented("template<typename tkey, typename tvalue, search_ds_for<tkey, tvalue> sds, typename hash> template<typename K> requires transparent_lookup_for<K, hash, sds> bool hash_table<tkey, tvalue, sds, hash>::contains(const K&) const", "your code should be here...");
+}
+
 // endregion lookup implementation
 
 // region modifiers implementation
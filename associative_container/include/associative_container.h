@@ -1,6 +1,7 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_ASSOCIATIVE_CONTAINER_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_ASSOCIATIVE_CONTAINER_H
 
+#include <concepts>
 #include <iostream>
 #include <vector>
 #include <operation_not_supported.h>
@@ -11,9 +12,34 @@ concept compator = requires(const compare c, const tkey& lhs, const tkey& rhs)
                        {c(lhs, rhs)} -> std::same_as<bool>;
                    } && std::copyable<compare> && std::default_initializable<compare>;
 
+// Lookups by a key of another type need a comparator declaring is_transparent, as in the standard
+// containers, so that std::less<> finds std::string keys by a std::string_view without a temporary
+template<typename compare, typename key, typename tkey>
+concept transparent_compator = requires { typename compare::is_transparent; } &&
+                               requires(const compare c, const key& lookup, const tkey& stored)
+                               {
+                                   {c(lookup, stored)} -> std::convertible_to<bool>;
+                                   {c(stored, lookup)} -> std::convertible_to<bool>;
+                               };
+
+template<typename hash, typename key>
+concept transparent_hash = requires { typename hash::is_transparent; } &&
+                           requires(const hash h, const key& lookup)
+                           {
+                               {h(lookup)} -> std::convertible_to<size_t>;
+                           };
+
 template<typename f_iter, typename tkey, typename tval>
 concept input_iterator_for_pair = std::input_iterator<f_iter> && std::same_as<typename std::iterator_traits<f_iter>::value_type, std::pair<tkey, tval>>;
 
+// Tags constructors whose input goes in strictly ascending key order
+struct sorted_unique_t
+{
+    explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
 
 /**
  * You will strongly need this while doing your cursal work
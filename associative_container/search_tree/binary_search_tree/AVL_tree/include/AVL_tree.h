@@ -4,43 +4,56 @@
 #include <binary_search_tree.h>
 
 namespace __detail {
+    template<typename augment>
     class AVL_TAG;
 
-    template<typename tkey, typename tvalue, typename compare>
-    class bst_impl<tkey, tvalue, compare, AVL_TAG>
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    class bst_impl<tkey, tvalue, compare, AVL_TAG<augment>>
     {
     public:
         template<class ...Args>
-        static binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node *
-        create_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG> &cont, Args &&...args);
+        static binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *
+        create_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &cont, Args &&...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node*);
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node*);
+
+        static void destroy_node(pp_allocator<typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::value_type> &alloc, binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node*);
 
 
         //Does not invalidate node*, needed for splay tree
-        static void post_search(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node **) {}
+        static void post_search(binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node **) {}
 
         //Does not invalidate node*
-        static void post_insert(binary_search_tree<tkey, tvalue, compare, AVL_TAG> &cont,
-                                binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node **);
+        static void post_insert(binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &cont,
+                                binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node **);
+
+        static void post_build(binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *, size_t depth, size_t max_depth);
+
+        // Links detached left and right under pivot, keys of left less than its key and of right greater.
+        // Returns the detached root, O(difference of the heights)
+        static binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *
+        join(binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *left,
+             binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *pivot,
+             binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *right);
 
-        static void erase(binary_search_tree<tkey, tvalue, compare, AVL_TAG> &cont,
-                          binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node **);
+        static void unlink(binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &cont,
+                           binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node **);
 
-        static void swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG> &lhs,
-                         binary_search_tree<tkey, tvalue, compare, AVL_TAG> &rhs) noexcept;
+        static void swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &lhs,
+                         binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &rhs) noexcept;
     };
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>>
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, typename augment = no_augment>
 class AVL_tree final :
-        public binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG> {
-    using parent = binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>;
-    friend __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>;
+        public binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>> {
+    using parent = binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>;
+    friend __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG<augment>>;
 private:
 
     struct node final : public parent::node {
-        size_t height;
+        // a tree of 2^64 nodes is at most 93 high
+        unsigned char height;
 
         void recalculate_height() noexcept;
 
@@ -51,8 +64,6 @@ private:
 
         template<class ...Args>
         node(parent::node *par, Args &&... args);
-
-        ~node() noexcept override = default;
     };
 
 public:
@@ -548,6 +559,16 @@ public:
              pp_allocator<value_type> alloc = pp_allocator<value_type>(),
              logger *log = nullptr);
 
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    AVL_tree(sorted_unique_t, iterator begin, iterator end, const compare &cmp = compare(),
+             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+             logger *log = nullptr);
+
+    template<std::ranges::input_range Range>
+    AVL_tree(sorted_unique_t, Range &&range, const compare &cmp = compare(),
+             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+             logger *log = nullptr);
+
 public:
 
     ~AVL_tree() noexcept final = default;
@@ -562,6 +583,26 @@ public:
 
     void swap(parent &other) noexcept override;
 
+    // Moves the keys not less than key to the returned tree in O(log n), the sizes of both halves
+    // come from their subtree sizes
+    AVL_tree split(const tkey &key) requires std::same_as<augment, order_statistics>;
+
+    // Same split for trees without subtree sizes, which count the smaller half for size():
+    // O(log n + min(k, n - k)), so O(n) for a split in the middle
+    AVL_tree split_and_count(const tkey &key);
+
+    // Keys of left are less than the pivot's and keys of right greater, both trees are left empty.
+    // Throws std::invalid_argument if they are not or the trees use different allocators
+    static AVL_tree join(AVL_tree &&left, value_type pivot, AVL_tree &&right);
+
+    // Consume both trees, which must share an allocator (std::invalid_argument otherwise), working in
+    // parallel on pool. A key present in both trees keeps its value from lhs
+    static AVL_tree set_union(AVL_tree &&lhs, AVL_tree &&rhs, fork_join_pool &pool = fork_join_pool::shared());
+
+    static AVL_tree set_intersection(AVL_tree &&lhs, AVL_tree &&rhs, fork_join_pool &pool = fork_join_pool::shared());
+
+    static AVL_tree set_difference(AVL_tree &&lhs, AVL_tree &&rhs, fork_join_pool &pool = fork_join_pool::shared());
+
 
     using parent::erase;
     using parent::insert;
@@ -589,38 +630,44 @@ AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare &cmp
          logger *log = nullptr) -> AVL_tree<tkey, tvalue, compare>;
 
 namespace __detail {
-    template<typename tkey, typename tvalue, typename compare>
+    template<typename tkey, typename tvalue, typename compare, typename augment>
     template<class ...Args>
-    binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node *bst_impl<tkey, tvalue, compare, AVL_TAG>::create_node(
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG> &cont, Args &&...args) {
-        typename AVL_tree<tkey, tvalue, compare>::node *n = cont._allocator.template new_object<typename AVL_tree<tkey, tvalue, compare>::node>(
+    binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *bst_impl<tkey, tvalue, compare, AVL_TAG<augment>>::create_node(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &cont, Args &&...args) {
+        typename AVL_tree<tkey, tvalue, compare, augment>::node *n = cont._allocator.template new_object<typename AVL_tree<tkey, tvalue, compare, augment>::node>(
                 args ...);
         n->left_subtree = nullptr;
         n->right_subtree = nullptr;
-        return static_cast<binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node *>(n);
+        return static_cast<binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *>(n);
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, AVL_TAG>::delete_node(
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG> &cont,
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node *n) {
-        auto *avl_node = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(n);
-        cont._allocator.delete_object(n);
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<augment>>::delete_node(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &cont,
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *n) {
+        destroy_node(cont._allocator, n);
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, AVL_TAG>::post_insert(
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG> &cont,
-            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node **node) {
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<augment>>::destroy_node(
+            pp_allocator<typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::value_type> &alloc,
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *n) {
+        alloc.delete_object(static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(n));
+    }
 
-        typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node *cur = *node;
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<augment>>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &cont,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node **node) {
+
+        typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *cur = *node;
         while (cur != nullptr) {
-            static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(cur)->recalculate_height();
-            cur = AVL_tree<tkey, tvalue, compare>::rebalance(cur);
+            static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(cur)->recalculate_height();
+            cur = AVL_tree<tkey, tvalue, compare, augment>::rebalance(cur);
             if (cur == nullptr) {
                 break;
             }
-            static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(cur)->recalculate_height();
+            static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(cur)->recalculate_height();
             if (cur->parent == nullptr) {
                 cont._root = cur;
             }
@@ -628,118 +675,177 @@ namespace __detail {
         }
     }
 
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<augment>>::post_build(
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *n, size_t depth, size_t max_depth) {
+        static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(n)->recalculate_height();
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *
+    bst_impl<tkey, tvalue, compare, AVL_TAG<augment>>::join(
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *left,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *pivot,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node *right) {
+        using bst = binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>;
+        using avl = AVL_tree<tkey, tvalue, compare, augment>;
+
+        auto height = [](typename bst::node *n) -> int {
+            return n ? static_cast<typename avl::node *>(n)->height : 0;
+        };
+
+        auto link = [](typename bst::node *n, typename bst::node *l, typename bst::node *r) {
+            n->left_subtree = l;
+            n->right_subtree = r;
+            if (l != nullptr) {
+                l->parent = n;
+            }
+            if (r != nullptr) {
+                r->parent = n;
+            }
+            static_cast<typename avl::node *>(n)->recalculate_height();
+            bst::update_summary(n);
+        };
+
+        pivot->parent = nullptr;
+        if (std::abs(height(left) - height(right)) <= 1) {
+            link(pivot, left, right);
+            return pivot;
+        }
 
-    //Работает следующим образом:
-    //Если у удаляемого элемента нет правого поддерева, то мы просто передвигаем его левое поддерево на его место.
-    //Если у удаляемого элемента есть правое поддерево, то мы находим в нем самый левый элемент и ставим его на место удаляемого.
-    //После этого запускаем ребалансировку от нового элемента до корня.
-    //Не самый оптимальный алгоритм (вероятно), но ассимптотитечски он ничего не портит, О(log n) остается.
-    
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, AVL_TAG>::erase(
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG> &cont,
-            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node **node) {
-        auto &avl_tree = static_cast<AVL_tree<tkey, tvalue, compare> &>(cont);
-        auto *node_to_delete = *node;
-        if (node_to_delete == nullptr) {
-            throw std::out_of_range("Incorrect iterator for erase\n");
+        bool into_left = height(left) > height(right);
+        typename bst::node *root = into_left ? left : right;
+        typename bst::node *lower = into_left ? right : left;
+
+        // Down the inner spine of the higher tree to the first subtree at most one higher than the other
+        typename bst::node *above = nullptr;
+        typename bst::node *cur = root;
+        while (height(cur) > height(lower) + 1) {
+            above = cur;
+            cur = into_left ? cur->right_subtree : cur->left_subtree;
         }
 
-        auto *parent = node_to_delete->parent;
-        typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node *new_node = nullptr;
-        if (node_to_delete->right_subtree == nullptr) {
-            if (parent->left_subtree == node_to_delete) {
-                parent->left_subtree = node_to_delete->left_subtree;
-            } else {
-                parent->right_subtree = node_to_delete->left_subtree;
-            }
-            new_node = node_to_delete->left_subtree;
+        if (into_left) {
+            link(pivot, cur, lower);
+            above->right_subtree = pivot;
         } else {
-            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node *successor;
-
-            successor = node_to_delete->left_subtree;
-            while (successor->right_subtree) {
-                successor = successor->right_subtree;
-            }
+            link(pivot, lower, cur);
+            above->left_subtree = pivot;
+        }
+        pivot->parent = above;
+
+        // The subtree grew by at most one, as after an insertion
+        for (typename bst::node *n = above; n != nullptr; n = n->parent) {
+            static_cast<typename avl::node *>(n)->recalculate_height();
+            bst::update_summary(n);
+            n = avl::rebalance(n);
+            static_cast<typename avl::node *>(n)->recalculate_height();
+            root = n;
+        }
 
-            new_node = successor;
+        return root;
+    }
 
 
-            if (new_node->parent != nullptr) {
-                if (new_node->parent->right_subtree == new_node) {
-                    new_node->parent->right_subtree = new_node->right_subtree;
-                } else {
-                    new_node->parent->left_subtree = new_node->right_subtree;
-                }
-            }
-            static_cast<AVL_tree<tkey, tvalue, compare>::node *>(new_node)->recalculate_height();
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG<augment>>::unlink(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &cont,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>::node **node) {
+        using bst = binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>>;
+        using avl = AVL_tree<tkey, tvalue, compare, augment>;
 
+        typename bst::node *node_to_delete = *node;
+        if (node_to_delete == nullptr) {
+            throw std::out_of_range("Incorrect iterator for erase\n");
+        }
 
-            if (node_to_delete->parent != nullptr) {
-                if (node_to_delete->parent->right_subtree == node_to_delete) {
-                    node_to_delete->parent->right_subtree = new_node;
-                } else {
-                    node_to_delete->parent->left_subtree = new_node;
-                }
+        auto link_to = [&](typename bst::node *n) -> typename bst::node *& {
+            if (n->parent == nullptr) {
+                return cont._root;
             }
-
-            //Managing case when new_node is child of node_to_delete
+            return n == n->parent->left_subtree ? n->parent->left_subtree : n->parent->right_subtree;
+        };
+
+        typename bst::node *next = bst::get_next_infix(node_to_delete);
+
+        // Lowest node that lost a descendant, heights, summaries and balance are restored up from it
+        typename bst::node *from;
+        if (node_to_delete->left_subtree == nullptr || node_to_delete->right_subtree == nullptr) {
+            typename bst::node *child = node_to_delete->left_subtree != nullptr
+                                        ? node_to_delete->left_subtree
+                                        : node_to_delete->right_subtree;
+            link_to(node_to_delete) = child;
+            if (child != nullptr) {
+                child->parent = node_to_delete->parent;
+            }
+            from = node_to_delete->parent;
+        } else {
+            // The greatest node of the left subtree takes the place of the deleted one
+            typename bst::node *new_node = bst::rightmost(node_to_delete->left_subtree);
             if (new_node->parent == node_to_delete) {
-                new_node->right_subtree = node_to_delete->right_subtree;
+                from = new_node;
             } else {
+                from = new_node->parent;
+                from->right_subtree = new_node->left_subtree;
+                if (new_node->left_subtree != nullptr) {
+                    new_node->left_subtree->parent = from;
+                }
                 new_node->left_subtree = node_to_delete->left_subtree;
-                new_node->right_subtree = node_to_delete->right_subtree;
+                new_node->left_subtree->parent = new_node;
             }
+
+            new_node->right_subtree = node_to_delete->right_subtree;
+            new_node->right_subtree->parent = new_node;
+            link_to(node_to_delete) = new_node;
             new_node->parent = node_to_delete->parent;
+        }
 
-            if (new_node->left_subtree) {
-                new_node->left_subtree->parent = new_node;
-            }
-            if (new_node->right_subtree) {
-                new_node->right_subtree->parent = new_node;
+        while (from != nullptr) {
+            static_cast<typename avl::node *>(from)->recalculate_height();
+            bst::update_summary(from);
+            from = avl::rebalance(from);
+            static_cast<typename avl::node *>(from)->recalculate_height();
+            if (from->parent == nullptr) {
+                cont._root = from;
             }
+            from = from->parent;
         }
 
-        if (node_to_delete->parent == nullptr) {
-            avl_tree._root = new_node;
-        }
-        avl_tree.rebalance_to_root(new_node);
-        avl_tree._size--;
-        __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>::delete_node(cont, node_to_delete);
-        *node = new_node;
+        cont._size--;
+        *node = next;
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>::swap(
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG> &lhs,
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG> &rhs) noexcept {
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG<augment>>::swap(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &lhs,
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG<augment>> &rhs) noexcept {
     }
 }
 
 // region node implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void AVL_tree<tkey, tvalue, compare>::node::recalculate_height() noexcept {
-    auto *left = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(this->left_subtree);
-    auto *right = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(this->right_subtree);
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+void AVL_tree<tkey, tvalue, compare, augment>::node::recalculate_height() noexcept {
+    auto *left = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(this->left_subtree);
+    auto *right = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(this->right_subtree);
     int left_height = (left ? left->height : 0);
     int right_height = (right ? right->height : 0);
-    this->height = 1 + std::max(left_height, right_height);
+    this->height = static_cast<unsigned char>(1 + std::max(left_height, right_height));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-short AVL_tree<tkey, tvalue, compare>::node::get_balance() const noexcept {
-    auto left = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(this->left_subtree);
-    auto right = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(this->right_subtree);
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+short AVL_tree<tkey, tvalue, compare, augment>::node::get_balance() const noexcept {
+    auto left = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(this->left_subtree);
+    auto right = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(this->right_subtree);
     short left_height = (left ? left->height : 0);
     short right_height = (right ? right->height : 0);
     return right_height - left_height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<class ...Args>
-AVL_tree<tkey, tvalue, compare>::node::node(parent::node *par, Args &&... args)
-        : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>::node(par,
+AVL_tree<tkey, tvalue, compare, augment>::node::node(parent::node *par, Args &&... args)
+        : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>::node(par,
                                                                              args ...) {
     height = 0;
 }
@@ -750,102 +856,102 @@ AVL_tree<tkey, tvalue, compare>::node::node(parent::node *par, Args &&... args)
 
 // region prefix_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::node *n) noexcept : parent::prefix_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator::prefix_iterator(parent::node *n) noexcept : parent::prefix_iterator(
         n) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept
         : parent::prefix_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::prefix_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::prefix_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::prefix_iterator.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::prefix_iterator.get_node())->get_balance();
 }
 
 // endregion prefix_iterator implementation
 
 // region prefix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::node *n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::prefix_const_iterator(parent::node *n) noexcept
         : parent::prefix_const_iterator(n) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::prefix_const_iterator(
         parent::prefix_const_iterator it) noexcept : parent::prefix_const_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept
         : parent::prefix_const_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::prefix_const_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::prefix_const_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::prefix_const_iterator::_base.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::prefix_const_iterator::_base.get_node())->get_balance();
 }
 
 // endregion prefix_const_iterator implementation
 
 // region prefix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node *n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node *n) noexcept
         : parent::prefix_reverse_iterator(n) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::prefix_reverse_iterator(
         parent::prefix_reverse_iterator it) noexcept : parent::prefix_reverse_iterator(it) {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::prefix_reverse_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::prefix_reverse_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::prefix_reverse_iterator::_base.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::prefix_reverse_iterator::_base.get_node())->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept
         : parent::prefix_reverse_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::prefix_iterator() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator() const noexcept {
     return parent::prefix_reverse_iterator::operator prefix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_iterator
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::base() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::base() const noexcept {
     return parent::prefix_reverse_iterator::base();
 }
 
@@ -853,41 +959,41 @@ AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::base() const noexcept
 
 // region prefix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(
         parent::node *n) noexcept : parent::prefix_const_reverse_iterator(n){
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(
         parent::prefix_const_reverse_iterator it) noexcept : parent::prefix_const_reverse_iterator(it){
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::prefix_const_reverse_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::prefix_const_reverse_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::prefix_const_reverse_iterator::_base.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::prefix_const_reverse_iterator::_base.get_node())->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(
         prefix_const_iterator it) noexcept : parent::prefix_const_reverse_iterator(it){
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::prefix_const_iterator() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator() const noexcept {
     return parent::prefix_const_reverse_iterator::operator prefix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::base() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::base() const noexcept {
     return parent::prefix_const_reverse_iterator::base();
 }
 
@@ -895,55 +1001,55 @@ AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::base() const noe
 
 // region infix_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::node *n) noexcept : parent::infix_iterator(n) {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_iterator::infix_iterator(parent::node *n) noexcept : parent::infix_iterator(n) {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept {
-    this->_data = it.get_data();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept
+        : parent::infix_iterator(it) {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::infix_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::infix_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::infix_iterator::get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::infix_iterator::get_node())->get_balance();
 }
 
 // endregion infix_iterator implementation
 
 // region infix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::node *n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator::infix_const_iterator(parent::node *n) noexcept
         : parent::infix_const_iterator(n) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept
         : parent::infix_const_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::infix_const_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::infix_const_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::infix_const_iterator::_base.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::infix_const_iterator::_base.get_node())->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept
         : parent::infix_const_iterator(it) {
 
 }
@@ -952,43 +1058,43 @@ AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infi
 
 // region infix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::node *n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::infix_reverse_iterator(parent::node *n) noexcept
         : parent::infix_reverse_iterator(n) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::infix_reverse_iterator(
         parent::infix_reverse_iterator it) noexcept {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::infix_reverse_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::infix_reverse_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::infix_reverse_iterator::_base.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::infix_reverse_iterator::_base.get_node())->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept
         : parent::infix_reverse_iterator::infix_reverse_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::infix_iterator() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::infix_iterator() const noexcept {
     return parent::infix_reverse_iterator::operator infix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::base() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::base() const noexcept {
     return parent::infix_reverse_iterator::base();
 }
 
@@ -996,43 +1102,43 @@ AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::base() const noexcept {
 
 // region infix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node *n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node *n) noexcept
         : parent::infix_const_reverse_iterator::infix_const_reverse_iterator(n) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(
         parent::infix_const_reverse_iterator it) noexcept : parent::infix_const_reverse_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::infix_const_reverse_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::infix_const_reverse_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::infix_const_reverse_iterator::_base.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::infix_const_reverse_iterator::_base.get_node())->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(
         infix_const_iterator it) noexcept : parent::infix_const_reverse_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::infix_const_iterator() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator() const noexcept {
     return parent::infix_const_reverse_iterator::operator infix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::base() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::base() const noexcept {
     return parent::infix_const_reverse_iterator::base();
 }
 
@@ -1040,58 +1146,58 @@ AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::base() const noex
 
 // region postfix_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::node *n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator::postfix_iterator(parent::node *n) noexcept
         : parent::postfix_iterator(n) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept
         : parent::postfix_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::postfix_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::postfix_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::postfix_iterator.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::postfix_iterator.get_node())->get_balance();
 }
 
 // endregion postfix_iterator implementation
 
 // region postfix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::node *n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::postfix_const_iterator(parent::node *n) noexcept
         : parent::postfix_const_iterator(n) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::postfix_const_iterator(
         parent::postfix_const_iterator it) noexcept: parent::postfix_const_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::postfix_const_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::postfix_const_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::postfix_const_iterator::_base.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::postfix_const_iterator::_base.get_node())->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept
         : parent::postfix_const_iterator(it) {
 
 }
@@ -1100,43 +1206,43 @@ AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(
 
 // region postfix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node *n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node *n) noexcept
         : parent::postfix_reverse_iterator(n) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::postfix_reverse_iterator(
         parent::postfix_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::postfix_reverse_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::postfix_reverse_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::postfix_reverse_iterator::_base.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::postfix_reverse_iterator::_base.get_node())->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept
         : parent::postfix_reverse_iterator(it) {
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::postfix_iterator() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator() const noexcept {
     return parent::postfix_reverse_iterator::operator postfix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_iterator
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::base() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::base() const noexcept {
     return parent::postfix_reverse_iterator::base();
 }
 
@@ -1144,43 +1250,43 @@ AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::base() const noexcept
 
 // region postfix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(
         parent::node *n) noexcept : parent::postfix_const_reverse_iterator(n){
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(
         parent::postfix_const_reverse_iterator it) noexcept : parent::postfix_const_reverse_iterator(it){
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::get_height() const noexcept {
-    auto *n = static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::postfix_const_reverse_iterator::_base.get_node());
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::get_height() const noexcept {
+    auto *n = static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::postfix_const_reverse_iterator::_base.get_node());
     return n->height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::get_balance() const noexcept {
-    return static_cast<AVL_tree<tkey, tvalue, compare>::node *>(parent::postfix_const_reverse_iterator::_base.get_node())->get_balance();
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::get_balance() const noexcept {
+    return static_cast<AVL_tree<tkey, tvalue, compare, augment>::node *>(parent::postfix_const_reverse_iterator::_base.get_node())->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(
         postfix_const_iterator it) noexcept : parent::postfix_const_reverse_iterator(it){
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::postfix_const_iterator() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator() const noexcept {
     return parent::postfix_const_reverse_iterator::operator postfix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::base() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::base() const noexcept {
     return parent::postfix_const_reverse_iterator::base();
 }
 
@@ -1189,294 +1295,294 @@ AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::base() const no
 // region iterator requests implementation
 
 // Infix iterators
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::begin() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator AVL_tree<tkey, tvalue, compare, augment>::begin() noexcept {
     return parent::begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::end() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::end() noexcept {
     return parent::end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::begin() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::begin() const noexcept {
     return parent::begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::end() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::end() const noexcept {
     return parent::end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::cbegin() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::cbegin() const noexcept {
     return parent::cbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::cend() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::cend() const noexcept {
     return parent::cend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rbegin() noexcept {
     return parent::rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rend() noexcept {
     return parent::rend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rbegin() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rbegin() const noexcept {
     return parent::rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rend() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rend() const noexcept {
     return parent::rend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::crbegin() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::crbegin() const noexcept {
     return parent::crbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::crend() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::crend() const noexcept {
     return parent::crend();
 }
 
 // region prefix iterators
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_iterator AVL_tree<tkey, tvalue, compare>::begin_prefix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator AVL_tree<tkey, tvalue, compare, augment>::begin_prefix() noexcept {
     return parent::begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_iterator AVL_tree<tkey, tvalue, compare>::end_prefix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator AVL_tree<tkey, tvalue, compare, augment>::end_prefix() noexcept {
     return parent::end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator
-AVL_tree<tkey, tvalue, compare>::begin_prefix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::begin_prefix() const noexcept {
     return parent::begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator
-AVL_tree<tkey, tvalue, compare>::end_prefix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::end_prefix() const noexcept {
     return parent::end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator
-AVL_tree<tkey, tvalue, compare>::cbegin_prefix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::cbegin_prefix() const noexcept {
     return parent::cbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator
-AVL_tree<tkey, tvalue, compare>::cend_prefix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::cend_prefix() const noexcept {
     return parent::cend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rbegin_prefix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rbegin_prefix() noexcept {
     return parent::rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rend_prefix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rend_prefix() noexcept {
     return parent::rend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rbegin_prefix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rbegin_prefix() const noexcept {
     return parent::rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rend_prefix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rend_prefix() const noexcept {
     return parent::rend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::crbegin_prefix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::crbegin_prefix() const noexcept {
     return parent::crbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::crend_prefix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::crend_prefix() const noexcept {
     return parent::crend_prefix();
 }
 
 // endregion prefix iterators
 // region infix iterators
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::begin_infix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::begin_infix() noexcept {
     return parent::begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::end_infix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::end_infix() noexcept {
     return parent::end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::begin_infix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::begin_infix() const noexcept {
     return parent::begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::end_infix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::end_infix() const noexcept {
     return parent::end_infix();
 }
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::cbegin_infix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::cbegin_infix() const noexcept {
     return parent::cbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::cend_infix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::cend_infix() const noexcept {
     return parent::cend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rbegin_infix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rbegin_infix() noexcept {
     return parent::rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rend_infix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rend_infix() noexcept {
     return parent::rend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rbegin_infix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rbegin_infix() const noexcept {
     return parent::rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rend_infix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rend_infix() const noexcept {
     return parent::rend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::crbegin_infix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::crbegin_infix() const noexcept {
     return parent::crbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::crend_infix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::crend_infix() const noexcept {
     return parent::crend_infix();
 }
 
 // endregion infix iterators
 
 // region postfix iterators
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_iterator
-AVL_tree<tkey, tvalue, compare>::begin_postfix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::begin_postfix() noexcept {
     return parent::begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_iterator
-AVL_tree<tkey, tvalue, compare>::end_postfix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::end_postfix() noexcept {
     return parent::end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator
-AVL_tree<tkey, tvalue, compare>::begin_postfix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::begin_postfix() const noexcept {
     return parent::begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator
-AVL_tree<tkey, tvalue, compare>::end_postfix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::end_postfix() const noexcept {
     return parent::end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator
-AVL_tree<tkey, tvalue, compare>::cbegin_postfix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::cbegin_postfix() const noexcept {
     return parent::cbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator
-AVL_tree<tkey, tvalue, compare>::cend_postfix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::cend_postfix() const noexcept {
     return parent::cend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rbegin_postfix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rbegin_postfix() noexcept {
     return parent::rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rend_postfix() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rend_postfix() noexcept {
     return parent::rend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rbegin_postfix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rbegin_postfix() const noexcept {
     return parent::rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::rend_postfix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::rend_postfix() const noexcept {
     return parent::rend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::crbegin_postfix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::crbegin_postfix() const noexcept {
     return parent::crbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-AVL_tree<tkey, tvalue, compare>::crend_postfix() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator
+AVL_tree<tkey, tvalue, compare, augment>::crend_postfix() const noexcept {
     return parent::crend_postfix();
 }
 
@@ -1489,58 +1595,78 @@ AVL_tree<tkey, tvalue, compare>::crend_postfix() const noexcept {
 // region AVL_tree constructors
 
 // Constructors
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(
         const compare &comp,
         pp_allocator<value_type> alloc,
-        logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>(comp, alloc, log) {
+        logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>(comp, alloc, log) {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(
         pp_allocator<value_type> alloc,
         const compare &comp,
-        logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>(alloc, comp, log) {
+        logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>(alloc, comp, log) {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(
         iterator begin, iterator end,
         const compare &cmp,
         pp_allocator<value_type> alloc,
-        logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>(begin, end, cmp, alloc) {
+        logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>(begin, end, cmp, alloc, log) {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<std::ranges::input_range Range>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(
         Range &&range,
         const compare &cmp,
         pp_allocator<value_type> alloc,
-        logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>(range, cmp, alloc, log) {
+        logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>(range, cmp, alloc, log) {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data,
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data,
                                           const compare &cmp, pp_allocator<value_type> alloc,
-                                          logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>(
-        data, alloc, log) {
+                                          logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>(
+        data, cmp, alloc, log) {
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(
+        sorted_unique_t tag,
+        iterator begin, iterator end,
+        const compare &cmp,
+        pp_allocator<value_type> alloc,
+        logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>(tag, begin, end, cmp, alloc, log) {
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+template<std::ranges::input_range Range>
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(
+        sorted_unique_t tag,
+        Range &&range,
+        const compare &cmp,
+        pp_allocator<value_type> alloc,
+        logger *log) : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>(tag, range, cmp, alloc, log) {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(const AVL_tree &other)
-        : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>(other) {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(const AVL_tree &other)
+        : binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>(other) {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare> &AVL_tree<tkey, tvalue, compare>::operator=(const AVL_tree &other) {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment> &AVL_tree<tkey, tvalue, compare, augment>::operator=(const AVL_tree &other) {
     parent::operator=(other);
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void AVL_tree<tkey, tvalue, compare>::swap(parent &other) noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+void AVL_tree<tkey, tvalue, compare, augment>::swap(parent &other) noexcept {
     parent::swap(other);
 }
 
@@ -1556,51 +1682,51 @@ void AVL_tree<tkey, tvalue, compare>::swap(parent &other) noexcept {
 // b   c    ---------------->       a
 //                                    c
 //
-template<typename tkey, typename tvalue, compator<tkey> compare>
-binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>::node *
-AVL_tree<tkey, tvalue, compare>::rebalance(parent::node *to_balance) {
-    auto *n = static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(to_balance);
-    auto *left = static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(n->left_subtree);
-    auto *right = static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(n->right_subtree);
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>::node *
+AVL_tree<tkey, tvalue, compare, augment>::rebalance(parent::node *to_balance) {
+    auto *n = static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(to_balance);
+    auto *left = static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(n->left_subtree);
+    auto *right = static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(n->right_subtree);
     if (n->get_balance() == 2) {
         auto hl = right->left_subtree
-                  ? static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(right->left_subtree)->height : 0;
+                  ? static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(right->left_subtree)->height : 0;
         auto hr = right->right_subtree
-                  ? static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(right->right_subtree)->height : 0;
+                  ? static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(right->right_subtree)->height : 0;
         if (hl <= hr) {
-            binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>::small_left_rotation(to_balance);
+            binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>::small_left_rotation(to_balance);
         } else {
-            binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>::big_left_rotation(to_balance);
+            binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>::big_left_rotation(to_balance);
         }
     } else if (n->get_balance() == -2) {
         auto hl = left->left_subtree
-                  ? static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(left->left_subtree)->height : 0;
+                  ? static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(left->left_subtree)->height : 0;
         auto hr = left->right_subtree
-                  ? static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(left->right_subtree)->height : 0;
+                  ? static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(left->right_subtree)->height : 0;
         if (hr <= hl) {
-            binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>::small_right_rotation(to_balance);
+            binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>::small_right_rotation(to_balance);
         } else {
-            binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>::big_right_rotation(to_balance);
+            binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG<augment>>::big_right_rotation(to_balance);
         }
     }
     n->recalculate_height();
     if (n->parent) {
         if (n->parent->left_subtree) {
-            static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(n->parent->left_subtree)->recalculate_height();
+            static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(n->parent->left_subtree)->recalculate_height();
         }
         if (n->parent->right_subtree) {
-            static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(n->parent->right_subtree)->recalculate_height();
+            static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(n->parent->right_subtree)->recalculate_height();
         }
     }
     return to_balance;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void AVL_tree<tkey, tvalue, compare>::rebalance_to_root(parent::node *from) {
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+void AVL_tree<tkey, tvalue, compare, augment>::rebalance_to_root(parent::node *from) {
     auto cur = from;
     while (cur != nullptr) {
-        cur = AVL_tree<tkey, tvalue, compare>::rebalance(cur);
-        static_cast<typename AVL_tree<tkey, tvalue, compare>::node *>(cur)->recalculate_height();
+        cur = AVL_tree<tkey, tvalue, compare, augment>::rebalance(cur);
+        static_cast<typename AVL_tree<tkey, tvalue, compare, augment>::node *>(cur)->recalculate_height();
         if (cur->parent == nullptr) {
             this->_root = cur;
         }
@@ -1608,6 +1734,76 @@ void AVL_tree<tkey, tvalue, compare>::rebalance_to_root(parent::node *from) {
     }
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment> AVL_tree<tkey, tvalue, compare, augment>::split_and_count(const tkey &key) {
+    AVL_tree result(compare(), this->_allocator, this->_logger);
+
+    typename parent::node *less;
+    typename parent::node *not_less;
+    this->split_subtree(this->_root, key, less, not_less);
+
+    size_t total = this->_size;
+    this->_root = less;
+    this->_size = parent::count_first(less, not_less, total);
+    result._root = not_less;
+    result._size = total - this->_size;
+
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment> AVL_tree<tkey, tvalue, compare, augment>::split(const tkey &key)
+requires std::same_as<augment, order_statistics> {
+    return split_and_count(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>
+AVL_tree<tkey, tvalue, compare, augment>::join(AVL_tree &&left, value_type pivot, AVL_tree &&right) {
+    if (!(left._allocator == right._allocator)) {
+        throw std::invalid_argument("Trees with different allocators can not be joined");
+    }
+    if ((left._root != nullptr && !left.compare_keys(parent::rightmost(left._root)->data.first, pivot.first)) ||
+        (right._root != nullptr && !left.compare_keys(pivot.first, parent::leftmost(right._root)->data.first))) {
+        throw std::invalid_argument("Keys of joined trees are out of order");
+    }
+
+    AVL_tree result(std::move(left));
+    auto *n = __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG<augment>>::create_node(result, nullptr,
+                                                                                      std::move(pivot));
+
+    result._root = __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG<augment>>::join(result._root, n, right._root);
+    result._size += right._size + 1;
+    right._root = nullptr;
+    right._size = 0;
+
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>
+AVL_tree<tkey, tvalue, compare, augment>::set_union(AVL_tree &&lhs, AVL_tree &&rhs, fork_join_pool &pool) {
+    AVL_tree result(std::move(lhs));
+    result.combine(std::move(rhs), parent::set_operation::unite, pool);
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>
+AVL_tree<tkey, tvalue, compare, augment>::set_intersection(AVL_tree &&lhs, AVL_tree &&rhs, fork_join_pool &pool) {
+    AVL_tree result(std::move(lhs));
+    result.combine(std::move(rhs), parent::set_operation::intersect, pool);
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>
+AVL_tree<tkey, tvalue, compare, augment>::set_difference(AVL_tree &&lhs, AVL_tree &&rhs, fork_join_pool &pool) {
+    AVL_tree result(std::move(lhs));
+    result.combine(std::move(rhs), parent::set_operation::subtract, pool);
+    return result;
+}
+
 // endregion AVL_tree methods
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_AVL_TREE_H
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <iostream>
+#include <map>
+#include <memory_resource>
+#include <optional>
 
 logger *create_logger(
         std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -136,6 +139,60 @@ bool postfix_iterator_test(
     return true;
 }
 
+// Fails on any deallocation whose size differs from the one the block was allocated with
+class sized_resource final : public std::pmr::memory_resource
+{
+    std::map<void *, size_t> _blocks;
+
+    size_t _allocations = 0;
+
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        void *p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        _blocks[p] = bytes;
+        ++_allocations;
+        return p;
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        EXPECT_EQ(_blocks.at(p), bytes);
+        _blocks.erase(p);
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+
+    size_t outstanding() const noexcept
+    {
+        return _blocks.size();
+    }
+
+    size_t allocations() const noexcept
+    {
+        return _allocations;
+    }
+};
+
+// Heights of the subtrees of every node differ by at most one
+template<typename tkey, typename tvalue, typename compare, typename augment>
+bool is_avl_balanced(AVL_tree<tkey, tvalue, compare, augment> &tree)
+{
+    for (auto it = tree.begin_infix(); it != tree.end_infix(); ++it)
+    {
+        if (std::abs(static_cast<long long>(it.get_balance())) > 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 TEST(AVLTreePositiveTests, test1)
 {
     std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
@@ -567,6 +624,530 @@ TEST(AVLTreePositiveTests, test11)
     logger->trace("AVLTreePositiveTests.test11 finished");
 }
 
+TEST(AVLTreePositiveTests, test12)
+{
+    sized_resource resource;
+
+    {
+        AVL_tree<int, std::string> tree(std::less<int>{}, pp_allocator<std::pair<const int, std::string>>(&resource));
+
+        for (int i = 0; i < 200; ++i)
+        {
+            tree.emplace((i * 37) % 200, std::to_string(i));
+        }
+    }
+
+    EXPECT_EQ(resource.outstanding(), 0);
+}
+
+TEST(AVLTreePositiveTests, test13)
+{
+    std::vector<std::pair<int, std::string>> sorted;
+    for (int i = 0; i < 1000; ++i)
+    {
+        sorted.emplace_back(i * 2, std::to_string(i));
+    }
+
+    AVL_tree<int, std::string> tagged(sorted_unique, sorted);
+    AVL_tree<int, std::string> detected(sorted.begin(), sorted.end());
+
+    for (auto *tree : {&tagged, &detected})
+    {
+        EXPECT_EQ(tree->size(), sorted.size());
+
+        auto expected = sorted.begin();
+        for (auto it = tree->begin_infix(); it != tree->end_infix(); ++it, ++expected)
+        {
+            ASSERT_NE(expected, sorted.end());
+            EXPECT_EQ(it->first, expected->first);
+            EXPECT_EQ(it->second, expected->second);
+            EXPECT_LE(std::abs(static_cast<long long>(it.get_balance())), 1);
+            EXPECT_LE(it.depth(), 9);
+        }
+        EXPECT_EQ(expected, sorted.end());
+
+        tree->emplace(1, "odd");
+        EXPECT_EQ(tree->at(1), "odd");
+        EXPECT_EQ(tree->size(), sorted.size() + 1);
+    }
+}
+
+TEST(AVLTreePositiveTests, test14)
+{
+    std::vector<std::pair<int, std::string>> unsorted = {{3, "c"}, {1, "a"}, {2, "b"}};
+
+    AVL_tree<int, std::string> tree(unsorted.begin(), unsorted.end());
+    std::vector<std::pair<const int, std::string>> actual(tree.begin(), tree.end());
+
+    std::vector<std::pair<const int, std::string>> expected = {{1, "a"}, {2, "b"}, {3, "c"}};
+
+    EXPECT_TRUE(compare_results(expected, actual));
+    EXPECT_EQ(tree.size(), 3);
+}
+
+TEST(AVLTreePositiveTests, test15)
+{
+    using tree_type = AVL_tree<int, std::string>;
+
+    for (int key : {-1, 0, 1, 250, 499, 500, 501, 998, 1000, 2000})
+    {
+        tree_type tree;
+        for (int i = 0; i < 1000; i += 2)
+        {
+            tree.emplace((i * 37) % 1000, std::to_string(i));
+        }
+
+        tree_type upper = tree.split_and_count(key);
+
+        EXPECT_TRUE(is_avl_balanced(tree));
+        EXPECT_TRUE(is_avl_balanced(upper));
+        EXPECT_EQ(tree.size(), static_cast<size_t>(std::clamp((key + 1) / 2, 0, 500)));
+        EXPECT_EQ(tree.size() + upper.size(), 500);
+        EXPECT_EQ(static_cast<size_t>(std::distance(tree.begin(), tree.end())), tree.size());
+        EXPECT_EQ(static_cast<size_t>(std::distance(upper.begin(), upper.end())), upper.size());
+        EXPECT_TRUE(std::all_of(tree.begin(), tree.end(), [key](auto const &kv) { return kv.first < key; }));
+        EXPECT_TRUE(std::all_of(upper.begin(), upper.end(), [key](auto const &kv) { return kv.first >= key; }));
+
+        // Keys are even, so the odd pivot lies between the two halves
+        tree_type joined = tree_type::join(std::move(tree), {key | 1, "pivot"}, upper.split_and_count(key | 1));
+
+        EXPECT_TRUE(is_avl_balanced(joined));
+        EXPECT_EQ(joined.at(key | 1), "pivot");
+        EXPECT_EQ(joined.size() + upper.size(), 501);
+        EXPECT_TRUE(std::is_sorted(joined.begin(), joined.end(),
+                                   [](auto const &lhs, auto const &rhs) { return lhs.first < rhs.first; }));
+    }
+}
+
+TEST(AVLTreePositiveTests, test16)
+{
+    using tree_type = AVL_tree<int, std::string>;
+
+    tree_type small({{1, "a"}});
+    tree_type large;
+    for (int i = 100; i < 400; ++i)
+    {
+        large.emplace(i, "b");
+    }
+
+    tree_type joined = tree_type::join(std::move(small), {50, "pivot"}, std::move(large));
+    EXPECT_TRUE(is_avl_balanced(joined));
+    EXPECT_EQ(joined.size(), 302);
+    EXPECT_EQ(small.size(), 0);
+    EXPECT_EQ(large.size(), 0);
+
+    tree_type extended = tree_type::join(tree_type(), {0, "c"}, std::move(joined));
+    EXPECT_TRUE(is_avl_balanced(extended));
+    EXPECT_EQ(extended.size(), 303);
+    EXPECT_EQ(extended.begin()->first, 0);
+
+    EXPECT_THROW(tree_type::join(tree_type({{5, "a"}}), {3, "b"}, tree_type()), std::invalid_argument);
+    EXPECT_THROW(tree_type::join(tree_type(), {3, "b"}, tree_type({{3, "c"}})), std::invalid_argument);
+}
+
+TEST(AVLTreePositiveTests, test17)
+{
+    using tree_type = AVL_tree<int, std::string>;
+
+    sized_resource resource;
+    pp_allocator<std::pair<const int, std::string>> alloc(&resource);
+    fork_join_pool pool(4);
+
+    std::map<int, std::string> lhs_keys;
+    std::map<int, std::string> rhs_keys;
+    for (int i = 0; i < 20000; ++i)
+    {
+        lhs_keys.emplace((i * 7919) % 40000 / 2 * 2, "lhs");
+        rhs_keys.emplace((i * 104729) % 60000 / 3 * 3, "rhs");
+    }
+
+    auto make = [&](std::map<int, std::string> const &keys)
+    {
+        tree_type tree(std::less<int>{}, alloc);
+        for (auto const &[key, value] : keys)
+        {
+            tree.emplace(key, value);
+        }
+        return tree;
+    };
+
+    using operation = tree_type (*)(tree_type &&, tree_type &&, fork_join_pool &);
+    for (auto [combine, keep_left, keep_both, keep_right] : {
+            std::tuple{operation(&tree_type::set_union), true, true, true},
+            std::tuple{operation(&tree_type::set_intersection), false, true, false},
+            std::tuple{operation(&tree_type::set_difference), true, false, false}})
+    {
+        std::map<int, std::string> expected;
+        for (auto const &[key, value] : lhs_keys)
+        {
+            if (rhs_keys.contains(key) ? keep_both : keep_left)
+            {
+                expected.emplace(key, value);
+            }
+        }
+        for (auto const &[key, value] : rhs_keys)
+        {
+            if (keep_right)
+            {
+                expected.emplace(key, value);
+            }
+        }
+
+        tree_type lhs = make(lhs_keys);
+        tree_type rhs = make(rhs_keys);
+        tree_type result = combine(std::move(lhs), std::move(rhs), pool);
+
+        EXPECT_TRUE(is_avl_balanced(result));
+        EXPECT_EQ(result.size(), expected.size());
+        EXPECT_EQ(rhs.size(), 0);
+        EXPECT_TRUE(std::equal(result.begin(), result.end(), expected.begin(), expected.end()));
+        EXPECT_EQ(resource.outstanding(), expected.size());
+    }
+
+    EXPECT_EQ(resource.outstanding(), 0);
+}
+
+TEST(AVLTreePositiveTests, test18)
+{
+    using tree_type = AVL_tree<int, std::string, std::less<int>, order_statistics>;
+
+    tree_type tree;
+    std::map<int, std::string> expected;
+
+    auto check = [&]
+    {
+        EXPECT_TRUE(is_avl_balanced(tree));
+        EXPECT_EQ(tree.size(), expected.size());
+
+        size_t index = 0;
+        for (auto const &[key, value] : expected)
+        {
+            EXPECT_EQ(tree.rank(key), index);
+            EXPECT_EQ(tree.rank(key + 1), index + 1);
+            EXPECT_EQ(tree.select(index)->first, key);
+            ++index;
+        }
+        EXPECT_TRUE(tree.select(expected.size()) == tree.end());
+
+        for (int lo = -5; lo < 1000; lo += 97)
+        {
+            for (int hi = lo - 50; hi < 1100; hi += 131)
+            {
+                auto count = lo < hi ? std::distance(expected.lower_bound(lo), expected.lower_bound(hi)) : 0;
+                EXPECT_EQ(tree.count_range(lo, hi), static_cast<size_t>(count));
+            }
+        }
+    };
+
+    for (int i = 0; i < 500; ++i)
+    {
+        int key = (i * 389) % 1000;
+        tree.emplace(key, std::to_string(i));
+        expected.emplace(key, std::to_string(i));
+    }
+    check();
+
+    for (int i = 0; i < 1000; i += 3)
+    {
+        if (expected.erase(i) != 0)
+        {
+            tree.erase(i);
+        }
+    }
+    check();
+
+    tree_type upper = tree.split(500);
+    auto middle = expected.lower_bound(500);
+    EXPECT_EQ(tree.size(), static_cast<size_t>(std::distance(expected.begin(), middle)));
+    EXPECT_EQ(upper.size(), static_cast<size_t>(std::distance(middle, expected.end())));
+    EXPECT_EQ(upper.rank(700), static_cast<size_t>(std::distance(middle, expected.lower_bound(700))));
+    EXPECT_EQ(upper.select(0)->first, middle->first);
+
+    tree = tree_type::join(std::move(tree), {499, "pivot"}, std::move(upper));
+    expected.emplace(499, "pivot");
+    check();
+}
+
+// Sum of the values, and the first and last key of a range, which only come out right if combine keeps the order
+struct value_sum_and_bounds
+{
+    struct value_type
+    {
+        long long sum = 0;
+        std::optional<int> first;
+        std::optional<int> last;
+    };
+
+    static value_type identity() noexcept
+    {
+        return {};
+    }
+
+    static value_type lift(const int &key, const int &value) noexcept
+    {
+        return {value, key, key};
+    }
+
+    static value_type combine(const value_type &lhs, const value_type &rhs) noexcept
+    {
+        return {lhs.sum + rhs.sum, lhs.first ? lhs.first : rhs.first, rhs.last ? rhs.last : lhs.last};
+    }
+};
+
+TEST(AVLTreePositiveTests, test19)
+{
+    using tree_type = AVL_tree<int, int, std::less<int>, value_sum_and_bounds>;
+
+    tree_type tree;
+    std::map<int, int> expected;
+
+    auto check = [&]
+    {
+        EXPECT_TRUE(is_avl_balanced(tree));
+
+        for (int lo = -10; lo < 2100; lo += 83)
+        {
+            for (int hi = lo - 40; hi < 2200; hi += 157)
+            {
+                long long sum = 0;
+                std::optional<int> first;
+                std::optional<int> last;
+                for (auto it = expected.lower_bound(lo); lo < hi && it != expected.lower_bound(hi); ++it)
+                {
+                    sum += it->second;
+                    first = first ? first : it->first;
+                    last = it->first;
+                }
+
+                auto result = tree.aggregate(lo, hi);
+                EXPECT_EQ(result.sum, sum);
+                EXPECT_EQ(result.first, first);
+                EXPECT_EQ(result.last, last);
+            }
+        }
+    };
+
+    for (int i = 0; i < 700; ++i)
+    {
+        int key = (i * 1543) % 2000;
+        tree.emplace(key, i);
+        expected.emplace(key, i);
+    }
+    check();
+
+    for (int i = 0; i < 2000; i += 5)
+    {
+        if (expected.erase(i) != 0)
+        {
+            tree.erase(i);
+        }
+    }
+    for (int i = 1; i < 2000; i += 7)
+    {
+        tree.insert_or_assign({i, -i});
+        expected.insert_or_assign(i, -i);
+    }
+    check();
+}
+
+// Counts the comparisons of all trees using it
+struct counting_less
+{
+    static inline size_t calls = 0;
+
+    bool operator()(int lhs, int rhs) const
+    {
+        ++calls;
+        return lhs < rhs;
+    }
+};
+
+TEST(AVLTreePositiveTests, test20)
+{
+    using tree_type = AVL_tree<int, int, counting_less, order_statistics>;
+
+    // Ascending even keys with a few late ones, as in a stream of timestamps
+    std::vector<std::pair<int, int>> stream;
+    for (int i = 0; i < 10000; ++i)
+    {
+        stream.emplace_back(i * 2, i);
+    }
+    for (int i = 100; i < 10000; i += 1000)
+    {
+        std::swap(stream[i], stream[i + 3]);
+    }
+
+    tree_type tree;
+    counting_less::calls = 0;
+    tree.insert(stream.begin(), stream.end());
+
+    EXPECT_LT(counting_less::calls, 3 * stream.size());
+    EXPECT_TRUE(is_avl_balanced(tree));
+
+    std::map<int, int> expected(stream.begin(), stream.end());
+    size_t hinted_calls = 0;
+    for (int i = 0; i < 3000; ++i)
+    {
+        int key = (i * 7919) % 20000 | 1;
+        if (!expected.emplace(key, -key).second)
+        {
+            continue;
+        }
+
+        // Far away, past the end and exact hints
+        auto next = expected.upper_bound(key);
+        auto hint = i % 3 == 0 ? tree.begin()
+                : i % 3 == 1 || next == expected.end() ? tree.end()
+                : tree.select(tree.rank(next->first));
+
+        counting_less::calls = 0;
+        auto it = tree.emplace_hint(hint, key, -key);
+        if (i % 3 == 2)
+        {
+            hinted_calls += counting_less::calls;
+        }
+
+        EXPECT_EQ(it->first, key);
+    }
+
+    EXPECT_LT(hinted_calls, 1000 * 3);
+    EXPECT_TRUE(is_avl_balanced(tree));
+    EXPECT_EQ(tree.size(), expected.size());
+    EXPECT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+}
+
+TEST(AVLTreePositiveTests, test21)
+{
+    using tree_type = AVL_tree<int, std::string, std::less<int>, order_statistics>;
+
+    sized_resource resource;
+    pp_allocator<std::pair<const int, std::string>> alloc(&resource);
+
+    {
+        tree_type evens(std::less<int>{}, alloc);
+        tree_type triples(std::less<int>{}, alloc);
+        std::map<int, std::string> expected;
+        std::map<int, std::string> left_over;
+        for (int i = 0; i < 3000; ++i)
+        {
+            if (i % 2 == 0)
+            {
+                evens.emplace(i, "even");
+                expected.emplace(i, "even");
+            }
+            if (i % 3 == 0)
+            {
+                triples.emplace(i, "triple");
+                (i % 2 == 0 ? left_over : expected).emplace(i, "triple");
+            }
+        }
+
+        auto check = [](tree_type &tree, std::map<int, std::string> const &keys)
+        {
+            EXPECT_TRUE(is_avl_balanced(tree));
+            EXPECT_EQ(tree.size(), keys.size());
+            EXPECT_TRUE(std::equal(tree.begin(), tree.end(), keys.begin(), keys.end()));
+            for (size_t index = 0; index < keys.size(); index += 97)
+            {
+                EXPECT_EQ(tree.select(index)->first, std::next(keys.begin(), index)->first);
+            }
+        };
+
+        // Keys already in evens stay in triples, nothing is allocated or copied
+        size_t allocations = resource.allocations();
+        evens.merge(triples);
+        check(evens, expected);
+        check(triples, left_over);
+
+        auto node = evens.extract(9);
+        EXPECT_EQ(node.key(), 9);
+        EXPECT_EQ(node.mapped(), "triple");
+        node.mapped() = "moved";
+        expected.erase(9);
+
+        auto inserted = triples.insert(std::move(node));
+        EXPECT_TRUE(inserted.inserted);
+        EXPECT_TRUE(inserted.node.empty());
+        EXPECT_EQ(inserted.position->second, "moved");
+        left_over.emplace(9, "moved");
+
+        // Both trees have 12, the node comes back
+        auto refused = triples.insert(evens.extract(evens.select(7)));
+        EXPECT_FALSE(refused.inserted);
+        EXPECT_EQ(refused.node.key(), 12);
+        EXPECT_EQ(refused.position->second, "triple");
+        expected.erase(12);
+
+        auto hinted = evens.insert(evens.select(7), std::move(refused.node));
+        EXPECT_EQ(hinted->first, 12);
+        EXPECT_FALSE(refused.node);
+        expected.emplace(12, "even");
+
+        EXPECT_TRUE(evens.extract(1).empty());
+        EXPECT_EQ(resource.allocations(), allocations);
+        check(evens, expected);
+        check(triples, left_over);
+
+        tree_type other;
+        auto foreign = evens.extract(evens.begin());
+        EXPECT_THROW(other.insert(std::move(foreign)), std::invalid_argument);
+        EXPECT_THROW(other.merge(evens), std::invalid_argument);
+        EXPECT_EQ(resource.outstanding(), expected.size() + left_over.size());
+    }
+
+    EXPECT_EQ(resource.outstanding(), 0);
+}
+
+// Writes that would bypass the summaries
+template<typename tree_type>
+concept writes_values_in_place = requires(tree_type &tree)
+{
+    tree.at(4) = 50;
+} || requires(tree_type &tree)
+{
+    tree[4] = 50;
+} || requires(tree_type &tree)
+{
+    tree.begin()->second = 50;
+};
+
+TEST(AVLTreePositiveTests, test22)
+{
+    using tree_type = AVL_tree<int, int, std::less<int>, value_sum_and_bounds>;
+
+    static_assert(!writes_values_in_place<tree_type>);
+    static_assert(writes_values_in_place<AVL_tree<int, int>>);
+    static_assert(writes_values_in_place<AVL_tree<int, int, std::less<int>, order_statistics>>);
+
+    tree_type tree;
+    for (int i = 0; i < 10; ++i)
+    {
+        tree.emplace(i, 1);
+    }
+
+    tree.modify(4, [](int &value) { value = 50; });
+    EXPECT_EQ(tree.at(4), 50);
+    EXPECT_EQ(tree.aggregate(0, 100).sum, 59);
+    EXPECT_EQ(tree.aggregate(5, 100).sum, 5);
+    EXPECT_THROW(tree.modify(42, [](int &value) { value = 0; }), std::out_of_range);
+
+    // The summaries are recomputed even if the modification throws halfway
+    EXPECT_THROW(tree.modify(7, [](int &value)
+    {
+        value = 10;
+        throw std::runtime_error("halfway");
+    }), std::runtime_error);
+    EXPECT_EQ(tree.aggregate(0, 100).sum, 68);
+
+    // A node brings its summary from its old tree
+    tree_type other;
+    auto node = tree.extract(7);
+    node.mapped() = 100;
+    other.insert(std::move(node));
+    EXPECT_EQ(other.aggregate(0, 100).sum, 100);
+    EXPECT_EQ(tree.aggregate(0, 100).sum, 58);
+}
+
 int main(
     int argc,
     char **argv)
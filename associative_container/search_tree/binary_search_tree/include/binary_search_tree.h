@@ -1,8 +1,13 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
 
+#include <bit>
+#include <mutex>
 #include <stack>
+#include <stdexcept>
 #include <vector>
+#include <utility>
+#include <fork_join_pool.h>
 #include <logger.h>
 #include <not_implemented.h>
 #include <search_tree.h>
@@ -16,6 +21,45 @@ namespace __detail {
     class BST_TAG;
 }
 
+// Augmentations keep a summary of every subtree in its root node: a monoid of value_type with
+// identity(), lift(key, value) of a single node and an associative combine(lhs, rhs) of adjacent key
+// ranges, lhs holding the smaller keys. None of them may throw
+template<typename augment, typename tkey, typename tvalue>
+concept tree_augmentation = requires(const tkey &key, const tvalue &value, const typename augment::value_type &summary) {
+    { augment::identity() } -> std::convertible_to<typename augment::value_type>;
+    { augment::lift(key, value) } -> std::convertible_to<typename augment::value_type>;
+    { augment::combine(summary, summary) } -> std::convertible_to<typename augment::value_type>;
+};
+
+struct no_augment {
+    struct value_type {};
+};
+
+// Subtree sizes, for rank, select and count_range in O(log n)
+struct order_statistics {
+    using value_type = size_t;
+
+    static size_t identity() noexcept { return 0; }
+
+    template<typename tkey, typename tvalue>
+    static size_t lift(const tkey &, const tvalue &) noexcept { return 1; }
+
+    static size_t combine(size_t lhs, size_t rhs) noexcept { return lhs + rhs; }
+};
+
+namespace __detail {
+    // Tags of the trees taking an augmentation are templates over it
+    template<typename tag>
+    struct tag_augment {
+        using type = no_augment;
+    };
+
+    template<template<typename> class tag_template, typename augment>
+    struct tag_augment<tag_template<augment>> {
+        using type = augment;
+    };
+}
+
 
 template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, typename tag = __detail::BST_TAG>
 class binary_search_tree : private compare {
@@ -27,27 +71,44 @@ public:
 
 protected:
 
+    using augment_type = typename __detail::tag_augment<tag>::type;
+
+    static constexpr bool augmented = !std::is_same_v<augment_type, no_augment>;
 
+    // Summaries that depend on values go stale when a value is written through a reference, so such
+    // trees only hand out const values and take writes through insert_or_assign and modify
+    static constexpr bool values_summarized = augmented && !std::is_same_v<augment_type, order_statistics>;
+
+    using iterator_value_type = std::conditional_t<values_summarized, const value_type, value_type>;
+
+    // Not polymorphic, so nodes carry no vptr: derived trees extend it with their own node type,
+    // which only bst_impl<..., tag>::create_node and delete_node know and destroy.
+    // data comes last, so small fields of a derived node can take its tail padding
     struct node
     {
 
     public:
 
-        value_type data;
-
         node *parent;
         node *left_subtree;
         node *right_subtree;
 
-        template<class ...Args>
-        explicit node(node *parent, Args &&...args);
+        value_type data;
 
+        // Of the whole subtree, takes no space without an augmentation. Values are only written in
+        // place through insert_or_assign and modify, which update the summaries
+        [[no_unique_address]] typename augment_type::value_type summary;
 
-        virtual ~node() = default;
+        template<class ...Args>
+        explicit node(node *parent, Args &&...args);
     };
 
     inline bool compare_keys(const tkey &lhs, const tkey &rhs) const;
 
+    // Against a lookup key of another type, which only a transparent compare takes
+    template<typename lhs_t, typename rhs_t>
+    inline bool compare_keys(const lhs_t &lhs, const rhs_t &rhs) const;
+
     inline bool compare_pairs(const value_type &lhs, const value_type &rhs) const;
 
 public:
@@ -107,8 +168,8 @@ public:
 
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
-        using reference = value_type &;
-        using pointer = value_type *;
+        using reference = iterator_value_type &;
+        using pointer = iterator_value_type *;
         using iterator_category = std::bidirectional_iterator_tag;
 
         explicit prefix_iterator(node *data = nullptr);
@@ -203,8 +264,8 @@ public:
 
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
-        using reference = value_type &;
-        using pointer = value_type *;
+        using reference = iterator_value_type &;
+        using pointer = iterator_value_type *;
         using iterator_category = std::bidirectional_iterator_tag;
 
         explicit prefix_reverse_iterator(node *data = nullptr);
@@ -312,8 +373,8 @@ public:
 
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
-        using reference = value_type &;
-        using pointer = value_type *;
+        using reference = iterator_value_type &;
+        using pointer = iterator_value_type *;
         using iterator_category = std::bidirectional_iterator_tag;
 
 
@@ -354,6 +415,7 @@ public:
     };
 
     class infix_const_iterator {
+        friend binary_search_tree;
     protected:
 
         infix_iterator _base;
@@ -409,8 +471,8 @@ public:
 
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
-        using reference = value_type &;
-        using pointer = value_type *;
+        using reference = iterator_value_type &;
+        using pointer = iterator_value_type *;
         using iterator_category = std::bidirectional_iterator_tag;
 
         explicit infix_reverse_iterator(node *data = nullptr);
@@ -516,8 +578,8 @@ public:
 
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
-        using reference = value_type &;
-        using pointer = value_type *;
+        using reference = iterator_value_type &;
+        using pointer = iterator_value_type *;
         using iterator_category = std::bidirectional_iterator_tag;
 
         explicit postfix_iterator(node *data = nullptr);
@@ -609,8 +671,8 @@ public:
 
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
-        using reference = value_type &;
-        using pointer = value_type *;
+        using reference = iterator_value_type &;
+        using pointer = iterator_value_type *;
         using iterator_category = std::bidirectional_iterator_tag;
 
         explicit postfix_reverse_iterator(node *data = nullptr);
@@ -764,6 +826,18 @@ public:
                        pp_allocator<value_type> alloc = pp_allocator<value_type>(),
                        logger *log = nullptr);
 
+    // Keys of the input go in strictly ascending order, the tree is built balanced in O(n).
+    // The untagged constructors check forward ranges for that order themselves
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    binary_search_tree(sorted_unique_t, iterator begin, iterator end, const compare &cmp = compare(),
+                       pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+                       logger *log = nullptr);
+
+    template<std::ranges::input_range Range>
+    binary_search_tree(sorted_unique_t, Range &&range, const compare &cmp = compare(),
+                       pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+                       logger *log = nullptr);
+
 public:
 
     binary_search_tree(const binary_search_tree &other);
@@ -778,13 +852,19 @@ public:
 
 public:
 
-    tvalue &at(const tkey &key);
+    // Writable values only if no summary depends on them, modify writes them otherwise
+    tvalue &at(const tkey &key) requires (!values_summarized);
 
     const tvalue &at(const tkey &key) const;
 
-    tvalue &operator[](const tkey &key);
+    tvalue &operator[](const tkey &key) requires (!values_summarized);
+
+    tvalue &operator[](tkey &&key) requires (!values_summarized);
 
-    tvalue &operator[](tkey &&key);
+    // Calls fn(value) for the value of key, then recomputes the summaries above it even if fn throws.
+    // Throws std::out_of_range if there is no such key
+    template<typename F>
+    void modify(const tkey &key, F &&fn);
 
     bool empty() const noexcept;
 
@@ -805,6 +885,15 @@ public:
     template<class ...Args>
     std::pair<infix_iterator, bool> emplace(Args &&...args);
 
+    // Inserts as close as possible before hint. Takes O(1) comparisons if the key belongs right before or
+    // after hint, otherwise searches from the lowest ancestor of hint whose subtree spans the key
+    infix_iterator insert(infix_const_iterator hint, const value_type &);
+
+    infix_iterator insert(infix_const_iterator hint, value_type &&);
+
+    template<class ...Args>
+    infix_iterator emplace_hint(infix_const_iterator hint, Args &&...args);
+
     infix_iterator insert_or_assign(const value_type &);
 
     infix_iterator insert_or_assign(value_type &&);
@@ -833,6 +922,38 @@ public:
 
     infix_const_iterator upper_bound(const tkey &) const;
 
+    // region transparent lookup definition
+
+    // Same lookups by any type compare orders against tkey, only for a compare declaring is_transparent
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    tvalue &at(const K &key);
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    const tvalue &at(const K &key) const;
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    bool contains(const K &key) const;
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    infix_iterator find(const K &key);
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    infix_const_iterator find(const K &key) const;
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    infix_iterator lower_bound(const K &key);
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    infix_const_iterator lower_bound(const K &key) const;
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    infix_iterator upper_bound(const K &key);
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    infix_const_iterator upper_bound(const K &key) const;
+
+    // endregion transparent lookup definition
+
     infix_iterator erase(infix_iterator pos);
 
     infix_iterator erase(infix_const_iterator pos);
@@ -843,6 +964,103 @@ public:
 
     size_t erase(const tkey &key);
 
+    // region node handles definition
+
+    // Owns a node taken out of a tree by extract. Inserting it into a tree with an equal allocator
+    // relinks the same node, the element is neither copied nor moved
+    class node_type
+    {
+
+        friend binary_search_tree;
+
+        node *_node;
+
+        pp_allocator<value_type> _allocator;
+
+        node_type(node *n, const pp_allocator<value_type> &alloc) noexcept;
+
+    public:
+
+        using key_type = tkey;
+
+        using mapped_type = tvalue;
+
+        using allocator_type = pp_allocator<value_type>;
+
+        node_type() noexcept;
+
+        node_type(node_type &&other) noexcept;
+
+        node_type &operator=(node_type &&other) noexcept;
+
+        node_type(const node_type &) = delete;
+
+        node_type &operator=(const node_type &) = delete;
+
+        ~node_type() noexcept;
+
+        bool empty() const noexcept;
+
+        explicit operator bool() const noexcept;
+
+        const tkey &key() const;
+
+        tvalue &mapped() const;
+
+        allocator_type get_allocator() const;
+
+        void swap(node_type &other) noexcept;
+
+    };
+
+    struct insert_return_type
+    {
+        infix_iterator position;
+        bool inserted;
+        node_type node;
+    };
+
+    // Empty if there is no such key
+    node_type extract(const tkey &key);
+
+    node_type extract(infix_const_iterator pos);
+
+    // If the key is already there nothing is inserted and node is handed back in the result.
+    // Throws std::invalid_argument if node comes from a tree with another allocator
+    insert_return_type insert(node_type &&node);
+
+    // As insert(hint, value_type), leaves node as it is if the key is already there
+    infix_iterator insert(infix_const_iterator hint, node_type &&node);
+
+    // Relinks the nodes of source whose keys are not in this tree yet, no node is allocated. Source is
+    // walked in order, each node searched from the previous one. Throws std::invalid_argument if the
+    // trees use different allocators
+    void merge(binary_search_tree &source);
+
+    void merge(binary_search_tree &&source);
+
+    // endregion node handles definition
+
+    // region order statistics definition
+
+    // Number of keys less than key
+    size_t rank(const tkey &key) const requires std::same_as<augment_type, order_statistics>;
+
+    // Element preceded by index others, end() if index is not less than size()
+    infix_iterator select(size_t index) requires std::same_as<augment_type, order_statistics>;
+
+    infix_const_iterator select(size_t index) const requires std::same_as<augment_type, order_statistics>;
+
+    // Number of keys in [lo, hi)
+    size_t count_range(const tkey &lo, const tkey &hi) const requires std::same_as<augment_type, order_statistics>;
+
+    // endregion order statistics definition
+
+    // Combined summary of the keys in [lo, hi) in ascending order, O(log n). Values of such a tree
+    // are const, modify and insert_or_assign keep the summaries up to date
+    typename augment_type::value_type aggregate(const tkey &lo, const tkey &hi) const
+    requires tree_augmentation<augment_type, tkey, tvalue>;
+
 public:
 
     // region iterators requests definition
@@ -968,8 +1186,35 @@ protected:
 
     // endregion subtree rotations definition
 
+    // region augmentation definition
+
+    static typename augment_type::value_type summary_of(node *n) noexcept;
+
+    // Recomputes the summary of n from its children, which must be up to date. Rotations do it for
+    // the nodes they move, so trees only call it where they link nodes themselves
+    static void update_summary(node *n) noexcept;
+
+    // Same for n and every ancestor, after the subtree of n changed
+    static void update_summaries(node *n) noexcept;
+
+    node *select_node(size_t index) const requires std::same_as<augment_type, order_statistics>;
+
+    // endregion augmentation definition
+
     node *go_to_node_with_key(const tkey &key);
 
+    // First node with a key equivalent to key, nullptr if there is none
+    template<typename K>
+    node *find_node(const K &key) const;
+
+    // First node whose key is not less than key, nullptr if there is none
+    template<typename K>
+    node *lower_bound_node(const K &key) const;
+
+    // First node whose key is greater than key, nullptr if there is none
+    template<typename K>
+    node *upper_bound_node(const K &key) const;
+
     static node *get_next_prefix(node *n);
 
     static node *get_prev_prefix(node *n);
@@ -981,6 +1226,107 @@ protected:
     static node *get_next_postfix(node *n);
 
     static node *get_prev_postfix(node *n);
+
+    // region sorted build definition
+
+    template<std::forward_iterator iterator, std::sentinel_for<iterator> sentinel>
+    bool is_sorted_unique(iterator first, sentinel last) const;
+
+    // Fills an empty tree with [first, last), keys strictly ascending; every node is created
+    // before any is linked, so a throwing allocation leaves the tree empty
+    template<std::input_iterator iterator, std::sentinel_for<iterator> sentinel>
+    void build_sorted(iterator first, sentinel last);
+
+    // Links nodes[0, count) as a perfectly balanced subtree of parent, returns its root
+    static node *link_sorted(node *const *nodes, size_t count, node *parent, size_t depth, size_t max_depth);
+
+    // endregion sorted build definition
+
+    // region insertion definition
+
+    // Parent for a new node with key and whether it goes to its left, nullptr for an empty tree.
+    // The search starts from near, a node close to the key, or from the root if it is nullptr
+    node *find_parent(const tkey &key, node *near, bool &left) const;
+
+    // Creates the node, links it and lets bst_impl<..., tag> rebalance
+    template<class ...Args>
+    node *link_new_node(node *parent, bool left, Args &&...args);
+
+    // Same for a node no tree owns
+    node *link_node(node *parent, bool left, node *n);
+
+    // Node with key right before the place find_parent gave for it, nullptr if the key is new
+    node *equal_before(const tkey &key, node *parent, bool left) const;
+
+    // Takes n out for a node_type and returns the next node in order
+    node *extract_node(node *n);
+
+    // The node of hint or, for end(), the last one
+    node *hint_node(const infix_const_iterator &hint) const noexcept;
+
+    // endregion insertion definition
+
+    // region split definition
+
+    // Cuts the detached subtree root into the keys less than key and the rest, both detached.
+    // Pieces are relinked by bst_impl<..., tag>::join, so only trees providing it can split
+    void split_subtree(node *root, const tkey &key, node *&less, node *&not_less) const;
+
+    // Same, but a node with key goes to equal, alone, instead of joining the greater keys
+    void split_subtree(node *root, const tkey &key, node *&less, node *&greater, node *&equal) const;
+
+    // Every key of the detached left is less than every key of the detached right
+    static node *join_pair(node *left, node *right);
+
+    // Unlinks the node with the greatest key into last, returns the rest
+    static node *split_last(node *root, node *&last);
+
+    // Size of first: its summary with order_statistics, otherwise walking both subtrees in infix order
+    // side by side, O(min) of their sizes
+    static size_t count_first(node *first, node *second, size_t total) noexcept;
+
+    static node *leftmost(node *n) noexcept;
+
+    static node *rightmost(node *n) noexcept;
+
+    // endregion split definition
+
+    // region set operations definition
+
+    enum class set_operation {
+        unite,
+        intersect,
+        subtract
+    };
+
+    struct set_context {
+        fork_join_pool &pool;
+
+        // forks stop below this depth, the recursion is balanced so that leaves a few tasks per worker
+        size_t fork_depth;
+
+        std::mutex lock;
+
+        // unlinked subtrees, freed by the calling thread once the recursion is done
+        std::vector<node *> dropped;
+
+        set_context(fork_join_pool &pool, size_t fork_depth) : pool(pool), fork_depth(fork_depth) {}
+
+        void drop(node *subtree);
+    };
+
+    // Splits rhs by the root key of lhs and combines the halves in parallel, O(m log(n / m + 1)) work
+    // for subtrees of m <= n nodes. Keys present in both keep the node of lhs
+    node *combine_subtrees(node *lhs, node *rhs, set_operation operation, set_context &context,
+                           size_t depth) const;
+
+    // Consumes other. Throws std::invalid_argument if it uses another allocator
+    void combine(binary_search_tree &&other, set_operation operation, fork_join_pool &pool);
+
+    // Returns the number of nodes freed
+    size_t destroy_subtree(node *root);
+
+    // endregion set operations definition
 };
 
 
@@ -1009,6 +1355,10 @@ namespace __detail {
         static void delete_node(binary_search_tree<tkey, tvalue, compare, tag> &cont,
                                 binary_search_tree<tkey, tvalue, compare, tag>::node *n);
 
+        //Destroys a node no tree owns any more, such as the one of a node_type
+        static void destroy_node(pp_allocator<typename binary_search_tree<tkey, tvalue, compare, tag>::value_type> &alloc,
+                                 binary_search_tree<tkey, tvalue, compare, tag>::node *n);
+
         //Does not invalidate node*, needed for splay tree
         static void post_search(binary_search_tree<tkey, tvalue, compare, tag>::node **) {}
 
@@ -1016,8 +1366,12 @@ namespace __detail {
         static void post_insert(binary_search_tree<tkey, tvalue, compare, tag> &cont,
                                 binary_search_tree<tkey, tvalue, compare, tag>::node **) {}
 
-        static void erase(binary_search_tree<tkey, tvalue, compare, tag> &cont,
-                          binary_search_tree<tkey, tvalue, compare, tag>::node **);
+        //Called for every node of a tree built from sorted input, after its subtrees; the deepest node is at max_depth
+        static void post_build(binary_search_tree<tkey, tvalue, compare, tag>::node *, size_t depth, size_t max_depth) {}
+
+        //Takes the node out of cont without destroying it, node* becomes the next one in order
+        static void unlink(binary_search_tree<tkey, tvalue, compare, tag> &cont,
+                           binary_search_tree<tkey, tvalue, compare, tag>::node **);
 
         static void swap(binary_search_tree<tkey, tvalue, compare, tag> &lhs,
                          binary_search_tree<tkey, tvalue, compare, tag> &rhs) noexcept;
@@ -1039,8 +1393,18 @@ template<input_iterator_for_pair<tkey, tvalue> iterator>
 binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(iterator begin, iterator end, const compare &cmp,
                                                                    pp_allocator<typename binary_search_tree<tkey, tvalue, compare, tag>::value_type> alloc,
                                                                    logger *logger) {
+    _root = nullptr;
     _allocator = alloc;
     _logger = logger;
+    _size = 0;
+
+    if constexpr (std::forward_iterator<iterator>) {
+        if (is_sorted_unique(begin, end)) {
+            build_sorted(begin, end);
+            return;
+        }
+    }
+
     insert(begin, end);
 }
 
@@ -1072,10 +1436,11 @@ binary_search_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const co
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 template<class ...Args>
-binary_search_tree<tkey, tvalue, compare, tag>::node::node(node *parent, Args &&...args) : data(args ...) {
-    binary_search_tree<tkey, tvalue, compare, tag>::node::parent = parent;
-    left_subtree = nullptr;
-    right_subtree = nullptr;
+binary_search_tree<tkey, tvalue, compare, tag>::node::node(node *parent, Args &&...args)
+        : parent(parent), left_subtree(nullptr), right_subtree(nullptr), data(args ...) {
+    if constexpr (augmented) {
+        summary = augment_type::lift(data.first, data.second);
+    }
 }
 
 // endregion node implementation
@@ -2108,23 +2473,54 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_ite
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 binary_search_tree<tkey, tvalue, compare, tag>::node *
 binary_search_tree<tkey, tvalue, compare, tag>::go_to_node_with_key(const tkey &key) {
-    binary_search_tree<tkey, tvalue, compare, tag>::node *current = _root;
+    return find_node(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::find_node(const K &key) const {
+    node *n = lower_bound_node(key);
+    return n != nullptr && !compare_keys(key, n->data.first) ? n : nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound_node(const K &key) const {
+    node *result = nullptr;
+    node *current = _root;
     while (current != nullptr) {
-        if (key == current->data.first) {
-            break;
+        if (compare_keys(current->data.first, key)) {
+            current = current->right_subtree;
+        } else {
+            result = current;
+            current = current->left_subtree;
         }
+    }
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound_node(const K &key) const {
+    node *result = nullptr;
+    node *current = _root;
+    while (current != nullptr) {
         if (compare_keys(key, current->data.first)) {
+            result = current;
             current = current->left_subtree;
         } else {
             current = current->right_subtree;
         }
     }
-    return current;
+    return result;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-tvalue &binary_search_tree<tkey, tvalue, compare, tag>::at(const tkey &key) {
-    node *current = go_to_node_with_key(key);
+tvalue &binary_search_tree<tkey, tvalue, compare, tag>::at(const tkey &key) requires (!values_summarized) {
+    node *current = find_node(key);
     if (current == nullptr) {
         throw std::out_of_range("Incorrect key");
     }
@@ -2133,19 +2529,40 @@ tvalue &binary_search_tree<tkey, tvalue, compare, tag>::at(const tkey &key) {
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 const tvalue &binary_search_tree<tkey, tvalue, compare, tag>::at(const tkey &key) const {
-    return (*this).at(key);
+    node *current = find_node(key);
+    if (current == nullptr) {
+        throw std::out_of_range("Incorrect key");
+    }
+    return current->data.second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-tvalue &binary_search_tree<tkey, tvalue, compare, tag>::operator[](const tkey &key) {
+tvalue &binary_search_tree<tkey, tvalue, compare, tag>::operator[](const tkey &key) requires (!values_summarized) {
     return go_to_node_with_key(key)->data.second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-tvalue &binary_search_tree<tkey, tvalue, compare, tag>::operator[](tkey &&key) {
+tvalue &binary_search_tree<tkey, tvalue, compare, tag>::operator[](tkey &&key) requires (!values_summarized) {
     return (*this)[key];
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename F>
+void binary_search_tree<tkey, tvalue, compare, tag>::modify(const tkey &key, F &&fn) {
+    node *current = find_node(key);
+    if (current == nullptr) {
+        throw std::out_of_range("Incorrect key");
+    }
+
+    try {
+        std::forward<F>(fn)(current->data.second);
+    } catch (...) {
+        update_summaries(current);
+        throw;
+    }
+    update_summaries(current);
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 bool binary_search_tree<tkey, tvalue, compare, tag>::empty() const noexcept {
     return _size == 0;
@@ -2177,135 +2594,148 @@ void binary_search_tree<tkey, tvalue, compare, tag>::swap(binary_search_tree &ot
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 bool binary_search_tree<tkey, tvalue, compare, tag>::contains(const tkey &key) const {
-    node *n = go_to_node_with_key(key);
-    return n == nullptr;
+    return find_node(key) != nullptr;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey &key) {
-    node *n = go_to_node_with_key(key);
-    infix_iterator it(n);
-    post_search(&n);
-    return it;
+    node *n = find_node(key);
+    return n == nullptr ? end() : infix_iterator(n);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey &key) const {
-    node *n = go_to_node_with_key(key);
-    infix_const_iterator it(n);
-    post_search(&n);
-    return it;
+    node *n = find_node(key);
+    return n == nullptr ? cend() : infix_const_iterator(n);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const tkey &key) {
-    node *current = _root;
-    while (current != nullptr) {
-        if (compare_keys(key, current->data.first)) {
-            if (compare_keys(key, current->left_subtree->data.first)) {
-
-                current = current->left_subtree;
-            } else {
-                break;
-            }
-        } else {
-            current = current->right_subtree;
-        }
-    }
-    if (current == nullptr) {
-        return end_infix();
-    }
-    infix_iterator it(current->left_subtree);
-
-    return it;
+    node *n = lower_bound_node(key);
+    return n == nullptr ? end() : infix_iterator(n);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const tkey &key) const {
-    node *current = _root;
-    while (current != nullptr) {
-        if (compare_keys(key, current->data.first)) {
-            if (current->left_subtree != nullptr && compare_keys(key, current->left_subtree->data.first)) {
-                current = current->left_subtree;
-            } else {
-                break;
-            }
-        } else {
-            current = current->right_subtree;
-        }
-    }
-    if (current == nullptr) {
-        return end_infix();
-    }
-    infix_const_iterator it(current);
-    return it;
+    node *n = lower_bound_node(key);
+    return n == nullptr ? cend() : infix_const_iterator(n);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey &key) {
-    node *current = _root;
-    node* prev = nullptr;
-    node* prev_prev = nullptr;
-    while (current != nullptr) {
-        prev_prev = prev;
-        prev = current;
-        if (compare_keys(key, current->data.first)) {
-            current = current->left_subtree;
-        } else {
-            current = current->right_subtree;
-        }
-    }
-
-    //   -  prev_prev  prev
-    auto mx = prev->data.first > prev_prev->data.first ? prev : prev_prev;
-    auto mn = prev->data.first < prev_prev->data.first ? prev : prev_prev;
-    if (compare_keys(key, mn->data.first)){
-        return infix_iterator(mn);
-    } else {
-        return infix_iterator(mx);
-    }
+    node *n = upper_bound_node(key);
+    return n == nullptr ? end() : infix_iterator(n);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey &key) const {
-    node *current = _root;
-    node* prev;
-    while (current != nullptr) {
-        prev = current;
-        if (compare_keys(key, current->data.first)) {
-            current = current->left_subtree;
-        } else {
-            current = current->right_subtree;
-        }
+    node *n = upper_bound_node(key);
+    return n == nullptr ? cend() : infix_const_iterator(n);
+}
+
+// region transparent lookup implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compator<compare, K, tkey>
+tvalue &binary_search_tree<tkey, tvalue, compare, tag>::at(const K &key) {
+    node *current = find_node(key);
+    if (current == nullptr) {
+        throw std::out_of_range("Incorrect key");
     }
-    infix_iterator it(prev);
+    return current->data.second;
+}
 
-    return it;
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compator<compare, K, tkey>
+const tvalue &binary_search_tree<tkey, tvalue, compare, tag>::at(const K &key) const {
+    node *current = find_node(key);
+    if (current == nullptr) {
+        throw std::out_of_range("Incorrect key");
+    }
+    return current->data.second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_iterator pos) {
-    node *n = pos.get_node();
-    __detail::bst_impl<tkey, tvalue, compare, tag>::erase(*this, &n);
-    infix_iterator it(n);
-    return it;
+template<typename K> requires transparent_compator<compare, K, tkey>
+bool binary_search_tree<tkey, tvalue, compare, tag>::contains(const K &key) const {
+    return find_node(key) != nullptr;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compator<compare, K, tkey>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_const_iterator pos) {
-    erase(pos._base());
+binary_search_tree<tkey, tvalue, compare, tag>::find(const K &key) {
+    node *n = find_node(key);
+    return n == nullptr ? end() : infix_iterator(n);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::find(const K &key) const {
+    node *n = find_node(key);
+    return n == nullptr ? cend() : infix_const_iterator(n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const K &key) {
+    node *n = lower_bound_node(key);
+    return n == nullptr ? end() : infix_iterator(n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const K &key) const {
+    node *n = lower_bound_node(key);
+    return n == nullptr ? cend() : infix_const_iterator(n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const K &key) {
+    node *n = upper_bound_node(key);
+    return n == nullptr ? end() : infix_iterator(n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const K &key) const {
+    node *n = upper_bound_node(key);
+    return n == nullptr ? cend() : infix_const_iterator(n);
+}
+
+// endregion transparent lookup implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_iterator pos) {
+    node *n = pos.get_node();
+    node *node_to_delete = n;
+    __detail::bst_impl<tkey, tvalue, compare, tag>::unlink(*this, &n);
+    __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, node_to_delete);
+    infix_iterator it(n);
+    return it;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_const_iterator pos) {
+    erase(pos._base());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_iterator first, infix_iterator last) {
     infix_iterator prev = first;
     infix_iterator cur = first;
@@ -2326,7 +2756,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_const_iterator first
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 size_t binary_search_tree<tkey, tvalue, compare, tag>::erase(const tkey &key) {
     node *n = go_to_node_with_key(key);
-    __detail::bst_impl<tkey, tvalue, compare, tag>::erase(*this, &n);
+    node *node_to_delete = n;
+    __detail::bst_impl<tkey, tvalue, compare, tag>::unlink(*this, &n);
+    __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, node_to_delete);
     return size();
 }
 
@@ -2434,14 +2866,10 @@ binary_search_tree<tkey, tvalue, compare, tag>::begin_prefix() noexcept {
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::end_prefix() noexcept {
+    // The last node in prefix order: right when possible, else left, down to a leaf
     node *tmp = _root;
-    while (tmp->left_subtree != nullptr) {
-        while (tmp->right_subtree != nullptr) {
-            tmp = tmp->right_subtree;
-        }
-        if (tmp->left_subtree != nullptr) {
-            tmp = tmp->left_subtree;
-        }
+    while (tmp != nullptr && (tmp->left_subtree != nullptr || tmp->right_subtree != nullptr)) {
+        tmp = tmp->right_subtree != nullptr ? tmp->right_subtree : tmp->left_subtree;
     }
     prefix_iterator res(nullptr);
     res._backup = tmp;
@@ -2459,14 +2887,10 @@ binary_search_tree<tkey, tvalue, compare, tag>::begin_prefix() const noexcept {
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::end_prefix() const noexcept {
+    // The last node in prefix order: right when possible, else left, down to a leaf
     node *tmp = _root;
-    while (tmp->left_subtree != nullptr) {
-        while (tmp->right_subtree != nullptr) {
-            tmp = tmp->right_subtree;
-        }
-        if (tmp->left_subtree != nullptr) {
-            tmp = tmp->left_subtree;
-        }
+    while (tmp != nullptr && (tmp->left_subtree != nullptr || tmp->right_subtree != nullptr)) {
+        tmp = tmp->right_subtree != nullptr ? tmp->right_subtree : tmp->left_subtree;
     }
     prefix_iterator it(nullptr);
     it._backup = tmp;
@@ -2824,6 +3248,9 @@ void binary_search_tree<tkey, tvalue, compare, tag>::small_left_rotation(node *&
         d->parent = a;
     }
     subtree_root = c;
+
+    update_summary(a);
+    update_summary(c);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
@@ -2875,6 +3302,9 @@ void binary_search_tree<tkey, tvalue, compare, tag>::small_right_rotation(node *
         c->parent = a;
     }
     subtree_root = b;
+
+    update_summary(a);
+    update_summary(b);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
@@ -2917,6 +3347,59 @@ void binary_search_tree<tkey, tvalue, compare, tag>::double_right_rotation(node
 
 // endregion
 
+// region augmentation implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::augment_type::value_type
+binary_search_tree<tkey, tvalue, compare, tag>::summary_of(node *n) noexcept {
+    if constexpr (augmented) {
+        return n == nullptr ? augment_type::identity() : n->summary;
+    } else {
+        return {};
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::update_summary(node *n) noexcept {
+    if constexpr (augmented) {
+        n->summary = augment_type::combine(
+                augment_type::combine(summary_of(n->left_subtree), augment_type::lift(n->data.first, n->data.second)),
+                summary_of(n->right_subtree));
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::update_summaries(node *n) noexcept {
+    if constexpr (augmented) {
+        for (; n != nullptr; n = n->parent) {
+            update_summary(n);
+        }
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::select_node(size_t index) const
+requires std::same_as<augment_type, order_statistics> {
+    node *n = _root;
+    while (n != nullptr) {
+        size_t left = summary_of(n->left_subtree);
+        if (index == left) {
+            return n;
+        }
+
+        if (index < left) {
+            n = n->left_subtree;
+        } else {
+            index -= left + 1;
+            n = n->right_subtree;
+        }
+    }
+    return nullptr;
+}
+
+// endregion augmentation implementation
+
 namespace __detail {
     template<typename tkey, typename tvalue, typename compare, typename tag>
     template<typename ...Args>
@@ -2931,100 +3414,70 @@ namespace __detail {
     template<typename tkey, typename tvalue, typename compare, typename tag>
     void bst_impl<tkey, tvalue, compare, tag>::delete_node(binary_search_tree<tkey, tvalue, compare, tag> &cont,
                                                            binary_search_tree<tkey, tvalue, compare, tag>::node *n) {
-        cont._allocator.delete_object(n);
+        destroy_node(cont._allocator, n);
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename tag>
+    void bst_impl<tkey, tvalue, compare, tag>::destroy_node(
+            pp_allocator<typename binary_search_tree<tkey, tvalue, compare, tag>::value_type> &alloc,
+            binary_search_tree<tkey, tvalue, compare, tag>::node *n) {
+        alloc.delete_object(n);
     }
 
     template<typename tkey, typename tvalue, typename compare, typename tag>
-    void bst_impl<tkey, tvalue, compare, tag>::erase(binary_search_tree<tkey, tvalue, compare, tag> &cont,
-                                                     typename binary_search_tree<tkey, tvalue, compare, tag>::node **node_ptr) {
+    void bst_impl<tkey, tvalue, compare, tag>::unlink(binary_search_tree<tkey, tvalue, compare, tag> &cont,
+                                                      typename binary_search_tree<tkey, tvalue, compare, tag>::node **node_ptr) {
+        using bst = binary_search_tree<tkey, tvalue, compare, tag>;
 
-        auto *node_to_delete = *node_ptr;
+        typename bst::node *node_to_delete = *node_ptr;
         if (node_to_delete == nullptr) {
             throw std::out_of_range("Incorrect iterator for erase\n");
         }
 
-        //node* prev = (std::prev(pos)).get_node();
-        auto *parent = node_to_delete->parent;
-        typename binary_search_tree<tkey, tvalue, compare, tag>::node *new_node = nullptr;
-        if ((node_to_delete->left_subtree == nullptr) && (node_to_delete->right_subtree == nullptr)) {
-            if (parent->left_subtree == node_to_delete) {
-                parent->left_subtree = nullptr;
-            } else {
-                parent->right_subtree = nullptr;
+        auto link_to = [&](typename bst::node *n) -> typename bst::node *& {
+            if (n->parent == nullptr) {
+                return cont._root;
             }
-        } else if (node_to_delete->left_subtree != nullptr && node_to_delete->right_subtree == nullptr) {
-            new_node = node_to_delete->left_subtree;
-            if (parent->left_subtree == node_to_delete) {
-                parent->left_subtree = new_node;
-                new_node->parent = node_to_delete->parent;
-            } else {
-                parent->right_subtree = new_node;
-                new_node->parent = node_to_delete->parent;
+            return n == n->parent->left_subtree ? n->parent->left_subtree : n->parent->right_subtree;
+        };
+
+        typename bst::node *next = bst::get_next_infix(node_to_delete);
+
+        // Lowest node that lost a descendant, summaries are restored up from it
+        typename bst::node *from;
+        if (node_to_delete->left_subtree == nullptr || node_to_delete->right_subtree == nullptr) {
+            typename bst::node *child = node_to_delete->left_subtree != nullptr
+                                        ? node_to_delete->left_subtree
+                                        : node_to_delete->right_subtree;
+            link_to(node_to_delete) = child;
+            if (child != nullptr) {
+                child->parent = node_to_delete->parent;
             }
-        } else if (node_to_delete->left_subtree == nullptr && node_to_delete->right_subtree != nullptr) {
-            new_node = node_to_delete->right_subtree;
-            if (parent != nullptr) {
-                if (parent->left_subtree == node_to_delete) {
-                    parent->left_subtree = new_node;
-                } else {
-                    parent->right_subtree = new_node;
-                }
-            } else {
-                cont._root = new_node;
-            }
-            new_node->parent = node_to_delete->parent;
+            from = node_to_delete->parent;
         } else {
-            typename binary_search_tree<tkey, tvalue, compare, tag>::node *successor;
-
-            successor = node_to_delete->left_subtree;
-            while (successor->right_subtree) {
-                successor = successor->right_subtree;
-            }
-
-            new_node = successor;
-            if (node_to_delete->parent != nullptr) {
-                if (node_to_delete->parent->right_subtree == node_to_delete) {
-                    node_to_delete->parent->right_subtree = new_node;
-                } else {
-                    node_to_delete->parent->left_subtree = new_node;
-                }
-            }
-
-            if (new_node->parent != nullptr) {
-                if (new_node->parent->right_subtree == new_node) {
-                    new_node->parent->right_subtree = new_node->left_subtree;
-                } else {
-                    node_to_delete->parent->left_subtree = new_node->left_subtree;
-                }
-            }
-
-            //Managing case when new_node is child f node_to_delete
+            // The greatest node of the left subtree takes the place of the deleted one
+            typename bst::node *new_node = bst::rightmost(node_to_delete->left_subtree);
             if (new_node->parent == node_to_delete) {
-                new_node->right_subtree = node_to_delete->right_subtree;
+                from = new_node;
             } else {
+                from = new_node->parent;
+                from->right_subtree = new_node->left_subtree;
+                if (new_node->left_subtree != nullptr) {
+                    new_node->left_subtree->parent = from;
+                }
                 new_node->left_subtree = node_to_delete->left_subtree;
-                new_node->right_subtree = node_to_delete->right_subtree;
+                new_node->left_subtree->parent = new_node;
             }
 
-
+            new_node->right_subtree = node_to_delete->right_subtree;
+            new_node->right_subtree->parent = new_node;
+            link_to(node_to_delete) = new_node;
             new_node->parent = node_to_delete->parent;
-
-            if (new_node->left_subtree) {
-                new_node->left_subtree->parent = new_node;
-            }
-            if (new_node->right_subtree) {
-                new_node->right_subtree->parent = new_node;
-            }
         }
 
-        if (node_to_delete->parent == nullptr) {
-            cont._root = new_node;
-        }
+        bst::update_summaries(from);
         cont._size--;
-        __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(cont, node_to_delete);
-
-
-        *node_ptr = new_node;
+        *node_ptr = next;
     }
 }
 
@@ -3090,6 +3543,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::operator=(binary_search_tree &&o
     _root = other._root;
     _logger = other._logger;
     _allocator = other._allocator;
+    _size = other._size;
+    other._root = nullptr;
+    other._size = 0;
     return *this;
 }
 
@@ -3123,6 +3579,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::get_next_prefix(node *n) {
     }
 
     node *parent = n->parent;
+    if (parent == nullptr) {
+        return nullptr;
+    }
     if (n == parent->left_subtree) {
         //we dont have any childs and we are left subtree.
         // This means that we have traversed all left subtree of our parent and now we have to go to the right subtree of one of our parents
@@ -3360,97 +3819,53 @@ binary_search_tree<tkey, tvalue, compare, tag>::get_prev_postfix(node *n) {
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool>
 binary_search_tree<tkey, tvalue, compare, tag>::insert(const value_type &value) {
-    node *prev = nullptr;
-    node *current = _root;
-    while (current != nullptr) {
-        if (compare_keys(value.first, current->data.first)) {
-            prev = current;
-            current = current->left_subtree;
-        } else {
-            prev = current;
-            current = current->right_subtree;
-        }
-    }
-    node *new_node;
-
-    new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, prev, value.first, value.second);
-    infix_iterator itt(new_node);
-    if (new_node == nullptr) {
-        return std::pair<infix_iterator, bool>(itt, false);
-    }
-    if (prev == nullptr) {
-        _root = new_node;
-        __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &new_node);
-        return std::pair<infix_iterator, bool>(itt, true);
-    }
-
-    infix_iterator it(new_node);
-    if (compare_keys(value.first, prev->data.first)) {
-        prev->left_subtree = new_node;
-    } else {
-        prev->right_subtree = new_node;
-    }
-    _size++;
-    __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &new_node);
-    return std::pair<infix_iterator, bool>(it, true);
+    bool left;
+    node *parent = find_parent(value.first, nullptr, left);
+    return std::pair<infix_iterator, bool>(infix_iterator(link_new_node(parent, left, value.first, value.second)), true);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool>
 binary_search_tree<tkey, tvalue, compare, tag>::insert(value_type &&value) {
-    node *prev = NULL;
-    node *current = _root;
-    while (current != nullptr) {
-        if (compare_keys(value.first, current->data.first)) {
-            prev = current;
-            current = current->left_subtree;
-        } else {
-            prev = current;
-            current = current->right_subtree;
-        }
-    }
-    node *new_node;
-
-    //differs from default insert only here
-    new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, prev, std::move(value.first), std::move(value.second));
-    infix_iterator itt(new_node);
-    if (new_node == nullptr) {
-        return std::pair<infix_iterator, bool>(itt, false);
-    }
+    bool left;
+    node *parent = find_parent(value.first, nullptr, left);
+    return std::pair<infix_iterator, bool>(
+            infix_iterator(link_new_node(parent, left, std::move(value.first), std::move(value.second))), true);
+}
 
-    if (prev == nullptr){
-        _root = new_node;
-        __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &new_node);
-        return std::pair<infix_iterator, bool>(itt, true);
-    }
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert(infix_const_iterator hint, const value_type &value) {
+    bool left;
+    node *parent = find_parent(value.first, hint_node(hint), left);
+    return infix_iterator(link_new_node(parent, left, value.first, value.second));
+}
 
-    infix_iterator it(new_node);
-    if (compare_keys(value.first, prev->data.first)) {
-        prev->left_subtree = new_node;
-    } else {
-        prev->right_subtree = new_node;
-    }
-    __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &new_node);
-    _size++;
-    return std::pair<infix_iterator, bool>(it, true);
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert(infix_const_iterator hint, value_type &&value) {
+    bool left;
+    node *parent = find_parent(value.first, hint_node(hint), left);
+    return infix_iterator(link_new_node(parent, left, std::move(value.first), std::move(value.second)));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 template<std::input_iterator InputIt>
 void binary_search_tree<tkey, tvalue, compare, tag>::insert(InputIt first, InputIt last) {
-    InputIt it = first;
-    while (it != last) {
-        insert((*it));
-        it++;
+    // Each element is searched from the previous one, O(1) comparisons apiece for sorted input
+    node *near = nullptr;
+    for (InputIt it = first; it != last; ++it) {
+        auto &&value = *it;
+        bool left;
+        node *parent = find_parent(value.first, near, left);
+        near = link_new_node(parent, left, value.first, value.second);
     }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 template<std::ranges::input_range R>
 void binary_search_tree<tkey, tvalue, compare, tag>::insert_range(R &&rg) {
-    for (const auto key: rg) {
-        insert(std::move(key));
-    }
+    insert(std::ranges::begin(rg), std::ranges::end(rg));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
@@ -3461,6 +3876,14 @@ binary_search_tree<tkey, tvalue, compare, tag>::emplace(Args &&... args) {
     return this->insert(std::move(n));
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<class ...Args>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::emplace_hint(infix_const_iterator hint, Args &&... args) {
+    value_type n(std::forward<Args>(args)...);
+    return insert(hint, std::move(n));
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(const value_type &value) {
@@ -3469,6 +3892,7 @@ binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(const value_typ
         return insert(value).first;
     } else {
         n->data.second = value.second;
+        update_summaries(n);
     }
     infix_iterator it(n);
     return it;
@@ -3477,12 +3901,15 @@ binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(const value_typ
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
 typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
 binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(value_type &&value) {
-    node *n = go_to_node_with_key(value->first);
-    if (n == NULL) {
-        insert(std::forward<value_type>(value));
+    node *n = go_to_node_with_key(value.first);
+    if (n == nullptr) {
+        return insert(std::move(value)).first;
     } else {
-        n->data.second = value.second;
+        n->data.second = std::move(value.second);
+        update_summaries(n);
     }
+    infix_iterator it(n);
+    return it;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
@@ -3540,6 +3967,14 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
     _logger = logger;
     _size = 0;
     _root = nullptr;
+
+    if constexpr (std::ranges::forward_range<Range>) {
+        if (is_sorted_unique(std::ranges::begin(range), std::ranges::end(range))) {
+            build_sorted(std::ranges::begin(range), std::ranges::end(range));
+            return;
+        }
+    }
+
     insert_range(range);
 }
 
@@ -3553,13 +3988,731 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
     _logger = logger;
     _size = 0;
     _root = nullptr;
+
+    if (is_sorted_unique(data.begin(), data.end())) {
+        build_sorted(data.begin(), data.end());
+        return;
+    }
+
     for (std::pair<tkey, tvalue> p: data) {
         insert(p);
     }
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
+        sorted_unique_t,
+        iterator begin,
+        iterator end,
+        const compare &cmp,
+        pp_allocator<value_type> alloc,
+        logger *logger) {
+    _allocator = alloc;
+    _logger = logger;
+    _size = 0;
+    _root = nullptr;
+    build_sorted(begin, end);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<std::ranges::input_range Range>
+binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
+        sorted_unique_t,
+        Range &&range,
+        const compare &cmp,
+        pp_allocator<value_type> alloc,
+        logger *logger) {
+    _allocator = alloc;
+    _logger = logger;
+    _size = 0;
+    _root = nullptr;
+    build_sorted(std::ranges::begin(range), std::ranges::end(range));
+}
+
 //endregion binary_search_tree methods_insert and methods_emplace implementation
 
+// region insertion implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::find_parent(const tkey &key, node *near, bool &left) const {
+    node *from = _root;
+    left = false;
+
+    if (near != nullptr) {
+        // Equal keys go after the ones already there, as in a search from the root
+        bool before = compare_keys(key, near->data.first);
+        node *neighbour = before ? get_prev_infix(near) : get_next_infix(near);
+
+        if (neighbour == nullptr || compare_keys(key, neighbour->data.first) != before) {
+            // Between near and its neighbour, one of which has a free child on the facing side
+            node *child = before ? near->left_subtree : near->right_subtree;
+            left = child == nullptr ? before : !before;
+            return child == nullptr ? near : neighbour;
+        }
+
+        // Up to the first ancestor across the key from near, the subtree below it spans the key
+        from = near;
+        while (from->parent != nullptr) {
+            node *parent = from->parent;
+            bool from_left = from == parent->left_subtree;
+            if (before ? !from_left && !compare_keys(key, parent->data.first)
+                       : from_left && compare_keys(key, parent->data.first)) {
+                break;
+            }
+            from = parent;
+        }
+    }
+
+    node *parent = nullptr;
+    while (from != nullptr) {
+        parent = from;
+        left = compare_keys(key, from->data.first);
+        from = left ? from->left_subtree : from->right_subtree;
+    }
+    return parent;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<class ...Args>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::link_new_node(node *parent, bool left, Args &&...args) {
+    return link_node(parent, left, __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(
+            *this, parent, std::forward<Args>(args)...));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::link_node(node *parent, bool left, node *n) {
+    n->parent = parent;
+    if (parent == nullptr) {
+        _root = n;
+    } else if (left) {
+        parent->left_subtree = n;
+    } else {
+        parent->right_subtree = n;
+    }
+
+    // n itself too, a node handle brings the summary of its old place
+    update_summaries(n);
+    _size++;
+    __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, &n);
+    return n;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::equal_before(const tkey &key, node *parent, bool left) const {
+    // Equal keys go right, so one already there is the last node before the place
+    node *before = parent != nullptr && left ? get_prev_infix(parent) : parent;
+    return before != nullptr && !compare_keys(before->data.first, key) ? before : nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::extract_node(node *n) {
+    node *next = n;
+    __detail::bst_impl<tkey, tvalue, compare, tag>::unlink(*this, &next);
+
+    // As fresh from create_node, bst_impl<..., tag>::post_insert restores the rest when it is linked again
+    n->parent = nullptr;
+    n->left_subtree = nullptr;
+    n->right_subtree = nullptr;
+    if constexpr (augmented) {
+        n->summary = augment_type::lift(n->data.first, n->data.second);
+    }
+    return next;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::hint_node(const infix_const_iterator &hint) const noexcept {
+    return hint._base._data != nullptr ? hint._base._data : rightmost(_root);
+}
+
+// endregion insertion implementation
+
+// region node handles implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag>::node_type::node_type(node *n, const pp_allocator<value_type> &alloc) noexcept
+        : _node(n), _allocator(alloc) {
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag>::node_type::node_type() noexcept
+        : _node(nullptr) {
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag>::node_type::node_type(node_type &&other) noexcept
+        : _node(std::exchange(other._node, nullptr)), _allocator(other._allocator) {
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node_type &
+binary_search_tree<tkey, tvalue, compare, tag>::node_type::operator=(node_type &&other) noexcept {
+    if (this != &other) {
+        node_type(std::move(other)).swap(*this);
+    }
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag>::node_type::~node_type() noexcept {
+    if (_node != nullptr) {
+        __detail::bst_impl<tkey, tvalue, compare, tag>::destroy_node(_allocator, _node);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+bool binary_search_tree<tkey, tvalue, compare, tag>::node_type::empty() const noexcept {
+    return _node == nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+binary_search_tree<tkey, tvalue, compare, tag>::node_type::operator bool() const noexcept {
+    return _node != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+const tkey &binary_search_tree<tkey, tvalue, compare, tag>::node_type::key() const {
+    if (_node == nullptr) {
+        throw std::logic_error("Empty node handle");
+    }
+    return _node->data.first;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+tvalue &binary_search_tree<tkey, tvalue, compare, tag>::node_type::mapped() const {
+    if (_node == nullptr) {
+        throw std::logic_error("Empty node handle");
+    }
+    return _node->data.second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node_type::allocator_type
+binary_search_tree<tkey, tvalue, compare, tag>::node_type::get_allocator() const {
+    return _allocator;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::node_type::swap(node_type &other) noexcept {
+    std::swap(_node, other._node);
+    std::swap(_allocator, other._allocator);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node_type
+binary_search_tree<tkey, tvalue, compare, tag>::extract(const tkey &key) {
+    node *n = go_to_node_with_key(key);
+    if (n == nullptr) {
+        return node_type();
+    }
+    extract_node(n);
+    return node_type(n, _allocator);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node_type
+binary_search_tree<tkey, tvalue, compare, tag>::extract(infix_const_iterator pos) {
+    node *n = pos._base._data;
+    extract_node(n);
+    return node_type(n, _allocator);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::insert_return_type
+binary_search_tree<tkey, tvalue, compare, tag>::insert(node_type &&node) {
+    if (node.empty()) {
+        return {end(), false, node_type()};
+    }
+    if (node._allocator != _allocator) {
+        throw std::invalid_argument("Node handle comes from a tree with another allocator");
+    }
+
+    bool left;
+    auto *parent = find_parent(node._node->data.first, nullptr, left);
+    if (auto *equal = equal_before(node._node->data.first, parent, left); equal != nullptr) {
+        return {infix_iterator(equal), false, std::move(node)};
+    }
+    return {infix_iterator(link_node(parent, left, std::exchange(node._node, nullptr))), true, node_type()};
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::insert(infix_const_iterator hint, node_type &&node) {
+    if (node.empty()) {
+        return end();
+    }
+    if (node._allocator != _allocator) {
+        throw std::invalid_argument("Node handle comes from a tree with another allocator");
+    }
+
+    bool left;
+    auto *parent = find_parent(node._node->data.first, hint_node(hint), left);
+    if (auto *equal = equal_before(node._node->data.first, parent, left); equal != nullptr) {
+        return infix_iterator(equal);
+    }
+    return infix_iterator(link_node(parent, left, std::exchange(node._node, nullptr)));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::merge(binary_search_tree &source) {
+    if (&source == this) {
+        return;
+    }
+    if (source._allocator != _allocator) {
+        throw std::invalid_argument("Trees to merge use different allocators");
+    }
+
+    node *near = nullptr;
+    node *n = leftmost(source._root);
+    while (n != nullptr) {
+        bool left;
+        node *parent = find_parent(n->data.first, near, left);
+        if (equal_before(n->data.first, parent, left) != nullptr) {
+            n = get_next_infix(n);
+            continue;
+        }
+
+        node *moved = n;
+        n = source.extract_node(n);
+        near = link_node(parent, left, moved);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::merge(binary_search_tree &&source) {
+    merge(source);
+}
+
+// endregion node handles implementation
+
+// region sorted build implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<std::forward_iterator iterator, std::sentinel_for<iterator> sentinel>
+bool binary_search_tree<tkey, tvalue, compare, tag>::is_sorted_unique(iterator first, sentinel last) const {
+    if (first == last) {
+        return true;
+    }
+
+    for (auto next = std::next(first); next != last; ++first, ++next) {
+        if (!compare_keys((*first).first, (*next).first)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<std::input_iterator iterator, std::sentinel_for<iterator> sentinel>
+void binary_search_tree<tkey, tvalue, compare, tag>::build_sorted(iterator first, sentinel last) {
+    std::vector<node *> nodes;
+    if constexpr (std::forward_iterator<iterator>) {
+        nodes.reserve(static_cast<size_t>(std::ranges::distance(first, last)));
+    }
+
+    try {
+        for (; first != last; ++first) {
+            nodes.push_back(__detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, nullptr, *first));
+        }
+    } catch (...) {
+        for (node *n: nodes) {
+            __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, n);
+        }
+        throw;
+    }
+
+    if (nodes.empty()) {
+        return;
+    }
+
+    _root = link_sorted(nodes.data(), nodes.size(), nullptr, 0, std::bit_width(nodes.size()) - 1);
+    _size = nodes.size();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::link_sorted(node *const *nodes, size_t count, node *parent,
+                                                            size_t depth, size_t max_depth) {
+    if (count == 0) {
+        return nullptr;
+    }
+
+    // Halves differ by at most one node, so every leaf is at max_depth or one above it
+    size_t middle = count / 2;
+    node *n = nodes[middle];
+    n->parent = parent;
+    n->left_subtree = link_sorted(nodes, middle, n, depth + 1, max_depth);
+    n->right_subtree = link_sorted(nodes + middle + 1, count - middle - 1, n, depth + 1, max_depth);
+
+    update_summary(n);
+    __detail::bst_impl<tkey, tvalue, compare, tag>::post_build(n, depth, max_depth);
+    return n;
+}
+
+// endregion sorted build implementation
+
+// region split implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::split_subtree(node *root, const tkey &key, node *&less,
+                                                                   node *&not_less) const {
+    if (root == nullptr) {
+        less = nullptr;
+        not_less = nullptr;
+        return;
+    }
+
+    node *left = root->left_subtree;
+    node *right = root->right_subtree;
+    if (left != nullptr) {
+        left->parent = nullptr;
+    }
+    if (right != nullptr) {
+        right->parent = nullptr;
+    }
+
+    // Recursion follows one root to leaf path, the joins along it cost O(height) in total
+    node *middle;
+    if (compare_keys(root->data.first, key)) {
+        split_subtree(right, key, middle, not_less);
+        less = __detail::bst_impl<tkey, tvalue, compare, tag>::join(left, root, middle);
+    } else {
+        split_subtree(left, key, less, middle);
+        not_less = __detail::bst_impl<tkey, tvalue, compare, tag>::join(middle, root, right);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::split_subtree(node *root, const tkey &key, node *&less,
+                                                                   node *&greater, node *&equal) const {
+    if (root == nullptr) {
+        less = nullptr;
+        greater = nullptr;
+        equal = nullptr;
+        return;
+    }
+
+    node *left = root->left_subtree;
+    node *right = root->right_subtree;
+    if (left != nullptr) {
+        left->parent = nullptr;
+    }
+    if (right != nullptr) {
+        right->parent = nullptr;
+    }
+
+    node *middle;
+    if (compare_keys(root->data.first, key)) {
+        split_subtree(right, key, middle, greater, equal);
+        less = __detail::bst_impl<tkey, tvalue, compare, tag>::join(left, root, middle);
+    } else if (compare_keys(key, root->data.first)) {
+        split_subtree(left, key, less, middle, equal);
+        greater = __detail::bst_impl<tkey, tvalue, compare, tag>::join(middle, root, right);
+    } else {
+        // Subtrees of a balanced tree are balanced, join accepts them as they are
+        root->left_subtree = nullptr;
+        root->right_subtree = nullptr;
+        less = left;
+        greater = right;
+        equal = root;
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::join_pair(node *left, node *right) {
+    if (left == nullptr) {
+        return right;
+    }
+    if (right == nullptr) {
+        return left;
+    }
+
+    node *last;
+    left = split_last(left, last);
+    return __detail::bst_impl<tkey, tvalue, compare, tag>::join(left, last, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::split_last(node *root, node *&last) {
+    node *left = root->left_subtree;
+    node *right = root->right_subtree;
+    if (left != nullptr) {
+        left->parent = nullptr;
+    }
+
+    if (right == nullptr) {
+        root->left_subtree = nullptr;
+        last = root;
+        return left;
+    }
+
+    right->parent = nullptr;
+    node *rest = split_last(right, last);
+    return __detail::bst_impl<tkey, tvalue, compare, tag>::join(left, root, rest);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::count_first(node *first, node *second, size_t total) noexcept {
+    if constexpr (std::same_as<augment_type, order_statistics>) {
+        return summary_of(first);
+    }
+
+    first = leftmost(first);
+    second = leftmost(second);
+
+    size_t steps = 0;
+    while (first != nullptr && second != nullptr) {
+        first = get_next_infix(first);
+        second = get_next_infix(second);
+        ++steps;
+    }
+
+    return first == nullptr ? steps : total - steps;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::leftmost(node *n) noexcept {
+    while (n != nullptr && n->left_subtree != nullptr) {
+        n = n->left_subtree;
+    }
+    return n;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::rightmost(node *n) noexcept {
+    while (n != nullptr && n->right_subtree != nullptr) {
+        n = n->right_subtree;
+    }
+    return n;
+}
+
+// endregion split implementation
+
+// region set operations implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::set_context::drop(node *subtree) {
+    if (subtree == nullptr) {
+        return;
+    }
+
+    std::lock_guard guard(lock);
+    dropped.push_back(subtree);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::node *
+binary_search_tree<tkey, tvalue, compare, tag>::combine_subtrees(node *lhs, node *rhs, set_operation operation,
+                                                                 set_context &context, size_t depth) const {
+    if (lhs == nullptr || rhs == nullptr) {
+        if (operation == set_operation::unite) {
+            return lhs != nullptr ? lhs : rhs;
+        }
+
+        context.drop(rhs);
+        if (operation == set_operation::intersect) {
+            context.drop(lhs);
+            return nullptr;
+        }
+        return lhs;
+    }
+
+    node *left = lhs->left_subtree;
+    node *right = lhs->right_subtree;
+    if (left != nullptr) {
+        left->parent = nullptr;
+    }
+    if (right != nullptr) {
+        right->parent = nullptr;
+    }
+    lhs->left_subtree = nullptr;
+    lhs->right_subtree = nullptr;
+
+    node *less;
+    node *greater;
+    node *equal;
+    split_subtree(rhs, lhs->data.first, less, greater, equal);
+
+    auto combine_left = [&] {
+        left = combine_subtrees(left, less, operation, context, depth + 1);
+    };
+    auto combine_right = [&] {
+        right = combine_subtrees(right, greater, operation, context, depth + 1);
+    };
+
+    if (depth < context.fork_depth) {
+        context.pool.fork_join(combine_left, combine_right);
+    } else {
+        combine_left();
+        combine_right();
+    }
+
+    context.drop(equal);
+
+    bool keep = operation == set_operation::unite || (operation == set_operation::intersect) == (equal != nullptr);
+    if (keep) {
+        return __detail::bst_impl<tkey, tvalue, compare, tag>::join(left, lhs, right);
+    }
+
+    context.drop(lhs);
+    return join_pair(left, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+void binary_search_tree<tkey, tvalue, compare, tag>::combine(binary_search_tree &&other, set_operation operation,
+                                                             fork_join_pool &pool) {
+    if (!(_allocator == other._allocator)) {
+        throw std::invalid_argument("Trees with different allocators can not be combined");
+    }
+
+    set_context context{pool, static_cast<size_t>(std::bit_width(pool.concurrency())) + 3};
+
+    size_t total = _size + other._size;
+    _root = combine_subtrees(_root, other._root, operation, context, 0);
+    other._root = nullptr;
+    other._size = 0;
+
+    // pp_allocator is not safe to share between threads, so nothing is freed during the recursion
+    size_t freed = 0;
+    for (node *subtree: context.dropped) {
+        freed += destroy_subtree(subtree);
+    }
+    _size = total - freed;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::destroy_subtree(node *root) {
+    size_t count = 0;
+    std::stack<node *> pending;
+    if (root != nullptr) {
+        pending.push(root);
+    }
+
+    while (!pending.empty()) {
+        node *n = pending.top();
+        pending.pop();
+        if (n->left_subtree != nullptr) {
+            pending.push(n->left_subtree);
+        }
+        if (n->right_subtree != nullptr) {
+            pending.push(n->right_subtree);
+        }
+        __detail::bst_impl<tkey, tvalue, compare, tag>::delete_node(*this, n);
+        ++count;
+    }
+
+    return count;
+}
+
+// endregion set operations implementation
+
+// region order statistics implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::rank(const tkey &key) const
+requires std::same_as<augment_type, order_statistics> {
+    size_t less = 0;
+    node *n = _root;
+    while (n != nullptr) {
+        if (compare_keys(n->data.first, key)) {
+            less += summary_of(n->left_subtree) + 1;
+            n = n->right_subtree;
+        } else {
+            n = n->left_subtree;
+        }
+    }
+    return less;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::select(size_t index)
+requires std::same_as<augment_type, order_statistics> {
+    node *n = select_node(index);
+    return n == nullptr ? end() : infix_iterator(n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag>::select(size_t index) const
+requires std::same_as<augment_type, order_statistics> {
+    node *n = select_node(index);
+    return n == nullptr ? cend() : infix_const_iterator(n);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+size_t binary_search_tree<tkey, tvalue, compare, tag>::count_range(const tkey &lo, const tkey &hi) const
+requires std::same_as<augment_type, order_statistics> {
+    if (!compare_keys(lo, hi)) {
+        return 0;
+    }
+    return rank(hi) - rank(lo);
+}
+
+// endregion order statistics implementation
+
+// region aggregate implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+typename binary_search_tree<tkey, tvalue, compare, tag>::augment_type::value_type
+binary_search_tree<tkey, tvalue, compare, tag>::aggregate(const tkey &lo, const tkey &hi) const
+requires tree_augmentation<augment_type, tkey, tvalue> {
+    auto lift = [](node *n) {
+        return augment_type::lift(n->data.first, n->data.second);
+    };
+
+    // Highest node in range, below it the range is a suffix of its left subtree and a prefix of its right
+    node *top = _root;
+    while (top != nullptr) {
+        if (compare_keys(top->data.first, lo)) {
+            top = top->right_subtree;
+        } else if (!compare_keys(top->data.first, hi)) {
+            top = top->left_subtree;
+        } else {
+            break;
+        }
+    }
+
+    if (top == nullptr) {
+        return augment_type::identity();
+    }
+
+    // Every node taken on the way down is followed by all the nodes taken before it
+    typename augment_type::value_type suffix = augment_type::identity();
+    for (node *n = top->left_subtree; n != nullptr;) {
+        if (compare_keys(n->data.first, lo)) {
+            n = n->right_subtree;
+        } else {
+            suffix = augment_type::combine(augment_type::combine(lift(n), summary_of(n->right_subtree)), suffix);
+            n = n->left_subtree;
+        }
+    }
+
+    typename augment_type::value_type prefix = augment_type::identity();
+    for (node *n = top->right_subtree; n != nullptr;) {
+        if (!compare_keys(n->data.first, hi)) {
+            n = n->left_subtree;
+        } else {
+            prefix = augment_type::combine(prefix, augment_type::combine(summary_of(n->left_subtree), lift(n)));
+            n = n->right_subtree;
+        }
+    }
+
+    return augment_type::combine(augment_type::combine(suffix, lift(top)), prefix);
+}
+
+// endregion aggregate implementation
+
 //return true if lhs < rhs
 //I do not know if this is what it is supposed to be.
 template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
@@ -3567,5 +4720,11 @@ bool binary_search_tree<tkey, tvalue, compare, tag>::compare_keys(const tkey &lh
     return compare()(lhs, rhs);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename lhs_t, typename rhs_t>
+bool binary_search_tree<tkey, tvalue, compare, tag>::compare_keys(const lhs_t &lhs, const rhs_t &rhs) const {
+    return compare()(lhs, rhs);
+}
+
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H;
 
@@ -5,31 +5,43 @@
 
 namespace __detail
 {
+    template<typename augment>
     class RB_TAG;
 
-    template<typename tkey, typename tvalue, typename compare>
-    class bst_impl<tkey, tvalue, compare, RB_TAG>
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    class bst_impl<tkey, tvalue, compare, RB_TAG<augment>>
     {
     public:
         template<class ...Args>
-        static binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, Args&& ...args);
+        static binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* create_node(binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>& cont, Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node*);
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node*);
+
+        static void destroy_node(pp_allocator<typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::value_type>& alloc, binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node*);
 
         //Does not invalidate node*, needed for splay tree
-        static void post_search(binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**){}
+        static void post_search(binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node**){}
 
         //Does not invalidate node*
-        static void post_insert(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**);
+        static void post_insert(binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node**);
+
+        static void post_build(binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node*, size_t depth, size_t max_depth);
+
+        // Restores the tree rooted at root after red z got a red parent, root ends black
+        static void insert_fixup(binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node*& root, binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* z);
+
+        // Links detached left and right under pivot, keys of left less than its key and of right greater.
+        // Returns the detached root, O(difference of the black heights)
+        static binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* join(binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* left, binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* pivot, binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* right);
 
-        static void erase(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**);
+        static void unlink(binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node**);
 
-        static void swap(binary_search_tree<tkey, tvalue, compare, RB_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, RB_TAG>& rhs) noexcept;
+        static void swap(binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>& lhs, binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>& rhs) noexcept;
     };
 }
 
-template<typename tkey,typename tvalue, compator<tkey> compare = std::less<tkey>>
-class red_black_tree final: public binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>
+template<typename tkey,typename tvalue, compator<tkey> compare = std::less<tkey>, typename augment = no_augment>
+class red_black_tree final: public binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>
 {
 
 public:
@@ -42,8 +54,8 @@ public:
 
 private:
 
-    using parent = binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>;
-    friend __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG>;
+    using parent = binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>;
+    friend __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG<augment>>;
 
     struct node final:
         parent::node
@@ -53,8 +65,6 @@ private:
         template<class ...Args>
         node(parent::node* par, Args&&... args);
 
-        ~node() noexcept override =default;
-
         node* get_parent()
         {
             return static_cast<node*>(this->parent);
@@ -114,6 +124,16 @@ public:
             pp_allocator<value_type> alloc = pp_allocator<value_type>(),
             logger* log = nullptr);
 
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    red_black_tree(sorted_unique_t, iterator begin, iterator end, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* log = nullptr);
+
+    template<std::ranges::input_range Range>
+    red_black_tree(sorted_unique_t, Range&& range, const compare& cmp = compare(),
+            pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+            logger* log = nullptr);
+
 
     // region iterator definition
 
@@ -559,6 +579,26 @@ public:
 
     void swap(parent& other) noexcept override;
 
+    // Moves the keys not less than key to the returned tree in O(log n), the sizes of both halves
+    // come from their subtree sizes
+    red_black_tree split(const tkey& key) requires std::same_as<augment, order_statistics>;
+
+    // Same split for trees without subtree sizes, which count the smaller half for size():
+    // O(log n + min(k, n - k)), so O(n) for a split in the middle
+    red_black_tree split_and_count(const tkey& key);
+
+    // Keys of left are less than the pivot's and keys of right greater, both trees are left empty.
+    // Throws std::invalid_argument if they are not or the trees use different allocators
+    static red_black_tree join(red_black_tree&& left, value_type pivot, red_black_tree&& right);
+
+    // Consume both trees, which must share an allocator (std::invalid_argument otherwise), working in
+    // parallel on pool. A key present in both trees keeps its value from lhs
+    static red_black_tree set_union(red_black_tree&& lhs, red_black_tree&& rhs, fork_join_pool& pool = fork_join_pool::shared());
+
+    static red_black_tree set_intersection(red_black_tree&& lhs, red_black_tree&& rhs, fork_join_pool& pool = fork_join_pool::shared());
+
+    static red_black_tree set_difference(red_black_tree&& lhs, red_black_tree&& rhs, fork_join_pool& pool = fork_join_pool::shared());
+
 
     /** Only rebinds iterators
      */
@@ -583,6 +623,9 @@ public:
     infix_iterator upper_bound(const tkey&);
     infix_const_iterator upper_bound(const tkey&) const;
 
+    infix_iterator select(size_t index) requires std::same_as<augment, order_statistics>;
+    infix_const_iterator select(size_t index) const requires std::same_as<augment, order_statistics>;
+
     infix_iterator erase(infix_iterator pos);
     infix_iterator erase(infix_const_iterator pos);
 
@@ -592,6 +635,9 @@ public:
     using parent::erase;
     using parent::insert;
     using parent::insert_or_assign;
+    using parent::find;
+    using parent::lower_bound;
+    using parent::upper_bound;
 };
 
 template<typename compare, typename U, typename iterator>
@@ -611,14 +657,15 @@ red_black_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compar
 
 namespace __detail {
 
+    template<typename augment>
     class RB_TAG {};
 
-    template<typename tkey, typename tvalue, typename compare>
+    template<typename tkey, typename tvalue, typename compare, typename augment>
     template<class ...Args>
-    binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* bst_impl<tkey, tvalue, compare, RB_TAG>::create_node(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, Args&& ...args)
+    binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* bst_impl<tkey, tvalue, compare, RB_TAG<augment>>::create_node(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>& cont, Args&& ...args)
     {
-        using rb = red_black_tree<tkey, tvalue, compare>;
+        using rb = red_black_tree<tkey, tvalue, compare, augment>;
 
         auto* node = cont._allocator.template new_object<typename rb::node>(std::forward<Args>(args)...);
 
@@ -629,33 +676,50 @@ namespace __detail {
         return node;
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, RB_TAG>::delete_node(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* n)
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<augment>>::delete_node(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* n)
+    {
+        destroy_node(cont._allocator, n);
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<augment>>::destroy_node(
+            pp_allocator<typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::value_type>& alloc, binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* n)
+    {
+        alloc.delete_object(static_cast<typename red_black_tree<tkey, tvalue, compare, augment>::node*>(n));
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<augment>>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node** n)
     {
-        cont._allocator.delete_object(n);
+        // A relinked node keeps the colour it had in its tree
+        static_cast<typename red_black_tree<tkey, tvalue, compare, augment>::node*>(*n)->color = red_black_tree<tkey, tvalue, compare, augment>::node_color::RED;
+        insert_fixup(cont._root, *n);
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, RB_TAG>::post_insert(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node** n)
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<augment>>::insert_fixup(
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node*& root,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* inserted)
     {
-        using bst = binary_search_tree<tkey, tvalue, compare, RB_TAG>;
-        using rb = red_black_tree<tkey, tvalue, compare>;
+        using bst = binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>;
+        using rb = red_black_tree<tkey, tvalue, compare, augment>;
         using rnode = typename rb::node;
 
         // Костыль, чтобы исправлять ссылки у родителей.
         auto link_to = [&](typename bst::node *n) -> typename bst::node *& {
-            if (n->parent == nullptr) return cont._root;
+            if (n->parent == nullptr) return root;
             return (n == n->parent->left_subtree)
                        ? n->parent->left_subtree
                        : n->parent->right_subtree;
         };
 
-        auto* z = static_cast<rnode*>(*n);
+        auto* z = static_cast<rnode*>(inserted);
 
-        while (z != static_cast<rnode*>(cont._root)
+        while (z != static_cast<rnode*>(root)
             && z->get_parent()->color == rb::node_color::RED)
         {
             rnode* parent = z->get_parent();
@@ -719,16 +783,119 @@ namespace __detail {
             }
         }
 
-        static_cast<rnode*>(cont._root)->color = rb::node_color::BLACK;
+        static_cast<rnode*>(root)->color = rb::node_color::BLACK;
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, RB_TAG>::erase(
-            binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node** n)
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* bst_impl<tkey, tvalue, compare, RB_TAG<augment>>::join(
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* left,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* pivot,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* right)
     {
-        using bst = binary_search_tree<tkey, tvalue, compare, RB_TAG>;
-        using rb = red_black_tree<tkey, tvalue, compare>;
+        using bst = binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>;
+        using rb = red_black_tree<tkey, tvalue, compare, augment>;
+        using rnode = typename rb::node;
+
+        auto is_black = [](typename bst::node* n)
+        {
+            return n == nullptr || static_cast<rnode*>(n)->color == rb::node_color::BLACK;
+        };
+
+        // Black nodes on every path down to a null, counting n itself
+        auto black_height = [&](typename bst::node* n)
+        {
+            size_t height = 0;
+            for (; n != nullptr; n = n->left_subtree)
+            {
+                height += is_black(n);
+            }
+            return height;
+        };
+
+        // Blackening a red root keeps the paths below it equal
+        for (auto* subtree : {left, right})
+        {
+            if (subtree != nullptr)
+            {
+                static_cast<rnode*>(subtree)->color = rb::node_color::BLACK;
+            }
+        }
+
+        auto link = [](typename bst::node* n, typename bst::node* l, typename bst::node* r)
+        {
+            n->left_subtree = l;
+            n->right_subtree = r;
+            if (l != nullptr) l->parent = n;
+            if (r != nullptr) r->parent = n;
+            bst::update_summary(n);
+        };
+
+        size_t left_height = black_height(left);
+        size_t right_height = black_height(right);
+
+        pivot->parent = nullptr;
+        if (left_height == right_height)
+        {
+            link(pivot, left, right);
+            static_cast<rnode*>(pivot)->color = rb::node_color::BLACK;
+            return pivot;
+        }
+
+        bool into_left = left_height > right_height;
+        typename bst::node* root = into_left ? left : right;
+        typename bst::node* lower = into_left ? right : left;
+        size_t lower_height = into_left ? right_height : left_height;
+
+        // Down the inner spine of the higher tree to a black subtree of the other's black height
+        size_t height = into_left ? left_height : right_height;
+        typename bst::node* above = nullptr;
+        typename bst::node* cur = root;
+        while (!is_black(cur) || height > lower_height)
+        {
+            height -= is_black(cur);
+            above = cur;
+            cur = into_left ? cur->right_subtree : cur->left_subtree;
+        }
+
+        if (into_left)
+        {
+            link(pivot, cur, lower);
+            above->right_subtree = pivot;
+        }
+        else
+        {
+            link(pivot, lower, cur);
+            above->left_subtree = pivot;
+        }
+        pivot->parent = above;
+        bst::update_summaries(above);
+
+        // A red pivot keeps black heights, what is left is a possible red parent, as after an insertion
+        static_cast<rnode*>(pivot)->color = rb::node_color::RED;
+        insert_fixup(root, pivot);
+
+        return root;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<augment>>::post_build(
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node* n, size_t depth, size_t max_depth)
+    {
+        using rb = red_black_tree<tkey, tvalue, compare, augment>;
+
+        // Only the deepest, possibly incomplete level is red, every path then has max_depth black nodes
+        static_cast<typename rb::node*>(n)->color = depth == max_depth && depth > 0
+                ? rb::node_color::RED
+                : rb::node_color::BLACK;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<augment>>::unlink(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>::node** n)
+    {
+        using bst = binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>>;
+        using rb = red_black_tree<tkey, tvalue, compare, augment>;
         using rnode = typename rb::node;
 
         auto color = [](rnode* p) -> typename rb::node_color
@@ -771,13 +938,17 @@ namespace __detail {
         rnode* z = static_cast<rnode*>(*n);
         if (!z) throw std::out_of_range("invalid iterator");
 
+        typename bst::node* next = bst::get_next_infix(z);
+
         rnode* y = z; // Удаляемая нода
         typename rb::node_color oc = y->color; // Цвет удаляемой ноды
         rnode* x = nullptr; // Поддерево заменяющей ноды
+        rnode* xp = nullptr; // Родитель x, который может быть nullptr
 
         if (!z->get_left() || !z->get_right())
         {
             x = z->get_left() ? z->get_left() : z->get_right();
+            xp = z->get_parent();
             transplant(z, x);
         }
         else
@@ -788,10 +959,12 @@ namespace __detail {
 
             if (y->parent == z)
             {
+                xp = y;
                 if (x) x->parent = y;
             }
             else
             {
+                xp = y->get_parent();
                 transplant(y, x);
                 y->left_subtree = z->left_subtree;
                 y->left_subtree->parent = y;
@@ -803,7 +976,9 @@ namespace __detail {
             y->color = z->color;
         }
 
-        delete_node(cont, z);
+        // xp is the lowest node that lost a descendant, the rotations below keep summaries on their own
+        bst::update_summaries(xp);
+
         --cont._size;
 
         if (oc == rb::node_color::BLACK)
@@ -811,24 +986,17 @@ namespace __detail {
             while (x != static_cast<rnode*>(cont._root)
                 && color(x) == rb::node_color::BLACK)
             {
-                rnode* xp = x ? x->get_parent() : nullptr;
-
-                if (xp == nullptr) // В корне
-                {
-                    if (x) x->color = rb::node_color::BLACK;
-                    break;
-                }
-
-                rnode* w = x->get_sibling();
+                rnode* w = static_cast<rnode*>(x == xp->get_left() ? xp->right_subtree : xp->left_subtree);
 
                 // Если нет родственника, обрабатываем этот случай как №2.
                 if (w == nullptr)
                 {
                     x = xp;
+                    xp = x->get_parent();
                     continue;
                 }
 
-                if (x == xp->get_left())
+                if (w == xp->get_right())
                 {
                     // 1. "w" is red" ------------------------------------------------------------------
                     if (color(w) == rb::node_color::RED)
@@ -842,13 +1010,14 @@ namespace __detail {
                     // 2. "w is black and both of w's children are black" ------------------------------
                     if (child_is_black(w, false) && child_is_black(w, true))
                     {
-                        if (w) w->color = rb::node_color::RED;
+                        w->color = rb::node_color::RED;
                         x = xp;
+                        xp = x->get_parent();
                         continue;
                     }
 
                     // 3. "w is black, w's left child is red, and w's right child is black" ------------
-                    if (!child_is_black(w, false) && child_is_black(w, true))
+                    if (child_is_black(w, true))
                     {
                         w->get_left()->color = rb::node_color::BLACK;
                         w->color = rb::node_color::RED;
@@ -856,15 +1025,14 @@ namespace __detail {
                         w = xp->get_right();
                     }
 
-                    // 4. "w is black, w's left child is black, and w's right child is red" ------------
+                    // 4. "w is black and w's right child is red" -------------------------------------
                     w->color = xp->color;
                     xp->color = rb::node_color::BLACK;
-                    if (rnode* wr = w->get_right())
-                        wr->color = rb::node_color::BLACK;
+                    w->get_right()->color = rb::node_color::BLACK;
                     bst::small_left_rotation(link_to(xp));
-                    break;
+                    x = static_cast<rnode*>(cont._root);
                 }
-                else /* x == xp->get_right() */
+                else
                 {
                     // 1. "w" is red" ------------------------------------------------------------------
                     if (color(w) == rb::node_color::RED)
@@ -878,471 +1046,496 @@ namespace __detail {
                     // 2. "w is black and both of w's children are black" ------------------------------
                     if (child_is_black(w, false) && child_is_black(w, true))
                     {
-                        if (w) w->color = rb::node_color::RED;
+                        w->color = rb::node_color::RED;
                         x = xp;
+                        xp = x->get_parent();
                         continue;
                     }
 
-                    // 3. "w is black, w's left child is black, and w's right child is red" ------------
-                    if (!child_is_black(w, true) && child_is_black(w, false))
+                    // 3. "w is black, w's right child is red, and w's left child is black" ------------
+                    if (child_is_black(w, false))
                     {
                         w->get_right()->color = rb::node_color::BLACK;
                         w->color = rb::node_color::RED;
-                        bst::small_left_rotation(link_to(xp));
+                        bst::small_left_rotation(link_to(w));
                         w = xp->get_left();
                     }
 
-                    // 4. "w is black, w's left child is red, and w's right child is black" ------------
+                    // 4. "w is black and w's left child is red" --------------------------------------
                     w->color = xp->color;
                     xp->color = rb::node_color::BLACK;
                     w->get_left()->color = rb::node_color::BLACK;
                     bst::small_right_rotation(link_to(xp));
-                    break;
+                    x = static_cast<rnode*>(cont._root);
                 }
             }
 
             if (x) x->color = rb::node_color::BLACK;
         }
 
-        *n = (x ? x : static_cast<rnode*>(cont._root));
+        *n = next;
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, RB_TAG>::swap(binary_search_tree<tkey, tvalue, compare, RB_TAG> &lhs,
-                                                                            binary_search_tree<tkey, tvalue, compare, RB_TAG> &rhs) noexcept
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, RB_TAG<augment>>::swap(binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>> &lhs,
+                                                                            binary_search_tree<tkey, tvalue, compare, RB_TAG<augment>> &rhs) noexcept
     {
         // 🤫
     }
 }
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<class ...Args>
-red_black_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)
-    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>::node(par, args...)
+red_black_tree<tkey, tvalue, compare, augment>::node::node(parent::node* par, Args&&... args)
+    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>::node(par, args...)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::red_black_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
         logger *log)
-    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>(comp, alloc, log)
+    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>(comp, alloc, log)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::red_black_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
         logger *log)
-    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>(alloc, comp, log)
+    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>(alloc, comp, log)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(
+red_black_tree<tkey, tvalue, compare, augment>::red_black_tree(
         iterator begin, iterator end,
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log)
-    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>(begin, end, cmp, alloc, log)
+    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>(begin, end, cmp, alloc, log)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<std::ranges::input_range Range>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(
+red_black_tree<tkey, tvalue, compare, augment>::red_black_tree(
         Range&& range,
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log)
-    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>(range, cmp, alloc, log)
+    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>(range, cmp, alloc, log)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::red_black_tree(
         std::initializer_list<std::pair<tkey, tvalue>> data,
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log)
-    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>(data, cmp, alloc, log)
+    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>(data, cmp, alloc, log)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+red_black_tree<tkey, tvalue, compare, augment>::red_black_tree(
+        sorted_unique_t tag,
+        iterator begin, iterator end,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* log)
+    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>(tag, begin, end, cmp, alloc, log)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+template<std::ranges::input_range Range>
+red_black_tree<tkey, tvalue, compare, augment>::red_black_tree(
+        sorted_unique_t tag,
+        Range&& range,
+        const compare& cmp,
+        pp_allocator<value_type> alloc,
+        logger* log)
+    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>(tag, range, cmp, alloc, log)
 {
 }
 
 // region iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_iterator::prefix_iterator(parent::node* n) noexcept
     : parent::prefix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept
     : parent::prefix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::prefix_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::prefix_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(parent::prefix_iterator::get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept
     : parent::prefix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept
     : parent::prefix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(parent::prefix_const_iterator::_base.get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept
     : parent::prefix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept
     : parent::prefix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept
     : parent::prefix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(prefix_reverse_iterator::get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept
     : parent::prefix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::prefix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, augment>::prefix_iterator() const noexcept
 {
     return parent::prefix_reverse_iterator::operator prefix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_iterator
-red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::base() const noexcept
 {
     return parent::prefix_reverse_iterator::base();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept
     : parent::prefix_const_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept
     : parent::prefix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(prefix_const_reverse_iterator::get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept
     : parent::prefix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::prefix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, augment>::prefix_const_iterator() const noexcept
 {
     return parent::prefix_const_reverse_iterator::operator prefix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
-red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::base() const noexcept
 {
     return parent::prefix_const_reverse_iterator::base();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_iterator::infix_iterator(parent::node* n) noexcept
     : parent::infix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept
     : parent::infix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::infix_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::infix_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(infix_iterator::get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept
     : parent::infix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept
     : parent::infix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(parent::infix_const_iterator::_base.get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept
     : parent::infix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept
     : parent::infix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept
     : parent::infix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(infix_reverse_iterator::get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept
     : parent::infix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::infix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, augment>::infix_iterator() const noexcept
 {
     return parent::infix_reverse_iterator::operator infix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::base() const noexcept
 {
     return parent::infix_reverse_iterator::base();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept
     : parent::infix_const_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept
     : parent::infix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(infix_const_reverse_iterator::get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept
     : parent::infix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::infix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator() const noexcept
 {
     return parent::infix_const_reverse_iterator::operator infix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::base() const noexcept
 {
     return parent::infix_const_reverse_iterator::base();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_iterator::postfix_iterator(parent::node* n) noexcept
     : parent::postfix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept
     : parent::postfix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::postfix_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::postfix_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(postfix_iterator::get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept
     : parent::postfix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept
     : parent::postfix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(parent::postfix_const_iterator::_base.get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept
     : parent::postfix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept
     : parent::postfix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept
     : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(postfix_reverse_iterator::get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept
     : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::postfix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, augment>::postfix_iterator() const noexcept
 {
     return parent::postfix_reverse_iterator::operator postfix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_iterator
-red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::base() const noexcept
 {
     return parent::postfix_reverse_iterator::base();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept
     : parent::postfix_const_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept
     : parent::postfix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::node_color
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::get_color() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::node_color
+red_black_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::get_color() const noexcept
 {
     auto* node = static_cast<red_black_tree::node*>(postfix_const_reverse_iterator::get_node());
     return node->color;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept
     : parent::postfix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare>::postfix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::operator red_black_tree<tkey, tvalue, compare, augment>::postfix_const_iterator() const noexcept
 {
     return parent::postfix_const_reverse_iterator::operator postfix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
-red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::base() const noexcept
 {
     return parent::postfix_const_reverse_iterator::base();
 }
@@ -1351,338 +1544,338 @@ red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::base() co
 
 // region iterator requests implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::begin() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::begin() noexcept
 {
     return parent::begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::end() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::end() noexcept
 {
     return parent::end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::begin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::begin() const noexcept
 {
     return parent::begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::end() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::end() const noexcept
 {
     return parent::end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::cbegin() const noexcept
 {
     return parent::cbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::cend() const noexcept
 {
     return parent::cend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rbegin() noexcept
 {
     return parent::rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rend() noexcept
 {
     return parent::rend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rbegin() const noexcept
 {
     return parent::rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rend() const noexcept
 {
     return parent::rend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::crbegin() const noexcept
 {
     return parent::crbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::crend() const noexcept
 {
     return parent::crend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_iterator
-red_black_tree<tkey, tvalue, compare>::begin_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::begin_prefix() noexcept
 {
     return parent::begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_iterator
-red_black_tree<tkey, tvalue, compare>::end_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::end_prefix() noexcept
 {
     return parent::end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
-red_black_tree<tkey, tvalue, compare>::begin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::begin_prefix() const noexcept
 {
     return parent::begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
-red_black_tree<tkey, tvalue, compare>::end_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::end_prefix() const noexcept
 {
     return parent::end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::cbegin_prefix() const noexcept
 {
     return parent::cbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::cend_prefix() const noexcept
 {
     return parent::cend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rbegin_prefix() noexcept
 {
     return parent::rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rend_prefix() noexcept
 {
     return parent::rend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rbegin_prefix() const noexcept
 {
     return parent::rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rend_prefix() const noexcept
 {
     return parent::rend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::crbegin_prefix() const noexcept
 {
     return parent::crbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::crend_prefix() const noexcept
 {
     return parent::crend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::begin_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::begin_infix() noexcept
 {
     return parent::begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::end_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::end_infix() noexcept
 {
     return parent::end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::begin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::begin_infix() const noexcept
 {
     return parent::begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::end_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::end_infix() const noexcept
 {
     return parent::end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::cbegin_infix() const noexcept
 {
     return parent::cbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::cend_infix() const noexcept
 {
     return parent::cend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rbegin_infix() noexcept
 {
     return parent::rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rend_infix() noexcept
 {
     return parent::rend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rbegin_infix() const noexcept
 {
     return parent::rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rend_infix() const noexcept
 {
     return parent::rend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::crbegin_infix() const noexcept
 {
     return parent::crbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::crend_infix() const noexcept
 {
     return parent::crend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_iterator
-red_black_tree<tkey, tvalue, compare>::begin_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::begin_postfix() noexcept
 {
     return parent::begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_iterator
-red_black_tree<tkey, tvalue, compare>::end_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::end_postfix() noexcept
 {
     return parent::end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
-red_black_tree<tkey, tvalue, compare>::begin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::begin_postfix() const noexcept
 {
     return parent::begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
-red_black_tree<tkey, tvalue, compare>::end_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::end_postfix() const noexcept
 {
     return parent::end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::cbegin_postfix() const noexcept
 {
     return parent::cbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_iterator
-red_black_tree<tkey, tvalue, compare>::cend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::cend_postfix() const noexcept
 {
     return parent::cend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rbegin_postfix() noexcept
 {
     return parent::rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rend_postfix() noexcept
 {
     return parent::rend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rbegin_postfix() const noexcept
 {
     return parent::rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::rend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::rend_postfix() const noexcept
 {
     return parent::rend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::crbegin_postfix() const noexcept
 {
     return parent::crbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator
-red_black_tree<tkey, tvalue, compare>::crend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator
+red_black_tree<tkey, tvalue, compare, augment>::crend_postfix() const noexcept
 {
     return parent::crend_postfix();
 }
@@ -1691,158 +1884,252 @@ red_black_tree<tkey, tvalue, compare>::crend_postfix() const noexcept
 
 // region rb_tree implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::~red_black_tree() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::~red_black_tree() noexcept
 {
     // no-op
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(red_black_tree const &other)
-    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>(other)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::red_black_tree(red_black_tree const &other)
+    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>(other)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare> &
-red_black_tree<tkey, tvalue, compare>::operator=(red_black_tree const &other)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment> &
+red_black_tree<tkey, tvalue, compare, augment>::operator=(red_black_tree const &other)
 {
     parent::operator=(other);
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare>::red_black_tree(red_black_tree &&other) noexcept
-    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>(std::forward<red_black_tree>(other))
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>::red_black_tree(red_black_tree &&other) noexcept
+    : binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG<augment>>(std::forward<red_black_tree>(other))
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-red_black_tree<tkey, tvalue, compare> &
-red_black_tree<tkey, tvalue, compare>::operator=(red_black_tree &&other) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment> &
+red_black_tree<tkey, tvalue, compare, augment>::operator=(red_black_tree &&other) noexcept
 {
     parent::operator=(std::forward<red_black_tree>(other));
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void red_black_tree<tkey, tvalue, compare>::swap(parent& other) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+void red_black_tree<tkey, tvalue, compare, augment>::swap(parent& other) noexcept
 {
     parent::swap(other);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment> red_black_tree<tkey, tvalue, compare, augment>::split_and_count(const tkey& key)
+{
+    red_black_tree result(compare(), this->_allocator, this->_logger);
+
+    typename parent::node* less;
+    typename parent::node* not_less;
+    this->split_subtree(this->_root, key, less, not_less);
+
+    // The pieces come out of join with black roots
+    size_t total = this->_size;
+    this->_root = less;
+    this->_size = parent::count_first(less, not_less, total);
+    result._root = not_less;
+    result._size = total - this->_size;
+
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment> red_black_tree<tkey, tvalue, compare, augment>::split(const tkey& key)
+requires std::same_as<augment, order_statistics>
+{
+    return split_and_count(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>
+red_black_tree<tkey, tvalue, compare, augment>::join(red_black_tree&& left, value_type pivot, red_black_tree&& right)
+{
+    if (!(left._allocator == right._allocator))
+    {
+        throw std::invalid_argument("Trees with different allocators can not be joined");
+    }
+    if ((left._root != nullptr && !left.compare_keys(parent::rightmost(left._root)->data.first, pivot.first)) ||
+        (right._root != nullptr && !left.compare_keys(pivot.first, parent::leftmost(right._root)->data.first)))
+    {
+        throw std::invalid_argument("Keys of joined trees are out of order");
+    }
+
+    red_black_tree result(std::move(left));
+    auto* n = __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG<augment>>::create_node(result, nullptr, std::move(pivot));
+
+    result._root = __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG<augment>>::join(result._root, n, right._root);
+    result._size += right._size + 1;
+    right._root = nullptr;
+    right._size = 0;
+
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>
+red_black_tree<tkey, tvalue, compare, augment>::set_union(red_black_tree&& lhs, red_black_tree&& rhs, fork_join_pool& pool)
+{
+    red_black_tree result(std::move(lhs));
+    result.combine(std::move(rhs), parent::set_operation::unite, pool);
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>
+red_black_tree<tkey, tvalue, compare, augment>::set_intersection(red_black_tree&& lhs, red_black_tree&& rhs, fork_join_pool& pool)
+{
+    red_black_tree result(std::move(lhs));
+    result.combine(std::move(rhs), parent::set_operation::intersect, pool);
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+red_black_tree<tkey, tvalue, compare, augment>
+red_black_tree<tkey, tvalue, compare, augment>::set_difference(red_black_tree&& lhs, red_black_tree&& rhs, fork_join_pool& pool)
+{
+    red_black_tree result(std::move(lhs));
+    result.combine(std::move(rhs), parent::set_operation::subtract, pool);
+    return result;
+}
+
 // endregion rb_tree implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool>
-red_black_tree<tkey, tvalue, compare>::insert(const value_type& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+std::pair<typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator, bool>
+red_black_tree<tkey, tvalue, compare, augment>::insert(const value_type& value)
 {
     return parent::insert(value);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool>
-red_black_tree<tkey, tvalue, compare>::insert(value_type&& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+std::pair<typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator, bool>
+red_black_tree<tkey, tvalue, compare, augment>::insert(value_type&& value)
 {
     return parent::insert(value);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<class ...Args>
-std::pair<typename red_black_tree<tkey, tvalue, compare>::infix_iterator, bool>
-red_black_tree<tkey, tvalue, compare>::emplace(Args&&... args)
+std::pair<typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator, bool>
+red_black_tree<tkey, tvalue, compare, augment>::emplace(Args&&... args)
 {
     return parent::emplace(args...);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::insert_or_assign(const value_type& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::insert_or_assign(const value_type& value)
 {
     return parent::insert_or_assign(value);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::insert_or_assign(value_type&& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::insert_or_assign(value_type&& value)
 {
     return parent::insert_or_assign(value);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<class ...Args>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::emplace_or_assign(Args&&... args)
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::emplace_or_assign(Args&&... args)
 {
     return parent::emplace_or_assign(std::forward<Args>(args)...);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::find(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::find(const tkey& key)
 {
     return parent::find(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::find(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::find(const tkey& key) const
 {
     return parent::find(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::lower_bound(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::lower_bound(const tkey& key)
 {
     return parent::lower_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::lower_bound(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::lower_bound(const tkey& key) const
 {
     return parent::lower_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::upper_bound(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::upper_bound(const tkey& key)
 {
     return parent::upper_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_const_iterator
-red_black_tree<tkey, tvalue, compare>::upper_bound(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::upper_bound(const tkey& key) const
 {
     return parent::upper_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::erase(infix_iterator pos)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::select(size_t index)
+requires std::same_as<augment, order_statistics>
+{
+    return parent::select(index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+red_black_tree<tkey, tvalue, compare, augment>::select(size_t index) const
+requires std::same_as<augment, order_statistics>
+{
+    return parent::select(index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::erase(infix_iterator pos)
 {
     return parent::erase(pos);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::erase(infix_const_iterator pos)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::erase(infix_const_iterator pos)
 {
     return parent::erase(pos);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::erase(infix_iterator first, infix_iterator last)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::erase(infix_iterator first, infix_iterator last)
 {
     return parent::erase(first, last);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename red_black_tree<tkey, tvalue, compare>::infix_iterator
-red_black_tree<tkey, tvalue, compare>::erase(infix_const_iterator first, infix_const_iterator last)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename red_black_tree<tkey, tvalue, compare, augment>::infix_iterator
+red_black_tree<tkey, tvalue, compare, augment>::erase(infix_const_iterator first, infix_const_iterator last)
 {
     return parent::erase(first, last);
 }
@@ -4,6 +4,9 @@
 #include <binary_search_tree.h>
 #include <iterator>
 
+template<typename tkey, typename tvalue, compator<tkey> compare>
+class scapegoat_tree;
+
 namespace __detail
 {
     class SPG_TAG;
@@ -17,13 +20,17 @@ namespace __detail
 
         static void delete_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*);
 
+        static void destroy_node(pp_allocator<typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::value_type>& alloc, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*);
+
         //Does not invalidate node*, needed for splay tree
         static void post_search(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
 
         //Does not invalidate node*
         static void post_insert(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
 
-        static void erase(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
+        static void post_build(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*, size_t depth, size_t max_depth);
+
+        static void unlink(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
 
         static void swap(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, SPG_TAG>& rhs) noexcept;
     };
@@ -52,6 +59,15 @@ namespace __detail {
         // TODO: implement
     }
 
+    // destroy_node
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::destroy_node(
+            pp_allocator<typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::value_type>& alloc,
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* node)
+    {
+        alloc.delete_object(static_cast<typename scapegoat_tree<tkey, tvalue, compare>::node*>(node));
+    }
+
     // post_search
     template<typename tkey, typename tvalue, typename compare>
     void bst_impl<tkey, tvalue, compare, SPG_TAG>::post_search(
@@ -69,9 +85,20 @@ namespace __detail {
         // TODO: implement
     }
 
-    // erase
+    // post_build
     template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, SPG_TAG>::erase(
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::post_build(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* node,
+            size_t depth,
+            size_t max_depth)
+    {
+        // A perfectly balanced build has no scapegoat, only subtree sizes to fill in
+        static_cast<typename scapegoat_tree<tkey, tvalue, compare>::node*>(node)->recalculate_size();
+    }
+
+    // unlink
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::unlink(
             binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont,
             binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node** node_ptr)
     {
@@ -97,6 +124,8 @@ class scapegoat_tree final:
 private:
 
     using parent = binary_search_tree<tkey, tvalue, compare, __detail::SPG_TAG>;
+
+    friend __detail::bst_impl<tkey, tvalue, compare, __detail::SPG_TAG>;
     
     struct node final:
         parent::node
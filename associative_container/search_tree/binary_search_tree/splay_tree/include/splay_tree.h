@@ -17,6 +17,8 @@ namespace __detail {
 
         static void delete_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node*);
 
+        static void destroy_node(pp_allocator<typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::value_type>& alloc, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node*);
+
         //Does not invalidate node*, needed for splay tree
         static void post_search(binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**);
 
@@ -24,8 +26,10 @@ namespace __detail {
         static void post_insert(binary_search_tree<tkey, tvalue, compare, SPL_TAG> &cont,
                                 binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node **);
 
-        static void erase(binary_search_tree<tkey, tvalue, compare, SPL_TAG> &cont,
-                          binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node **);
+        static void post_build(binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node *, size_t depth, size_t max_depth) {}
+
+        static void unlink(binary_search_tree<tkey, tvalue, compare, SPL_TAG> &cont,
+                           binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node **);
 
         static void swap(binary_search_tree<tkey, tvalue, compare, SPL_TAG> &lhs,
                          binary_search_tree<tkey, tvalue, compare, SPL_TAG> &rhs) noexcept;
@@ -78,6 +82,10 @@ public:
     splay_tree &operator=(splay_tree &&other) noexcept;
 
 public:
+    // Node handle insertion and merging of the base
+    using parent::insert;
+    using parent::merge;
+
     std::pair<typename binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG>::infix_iterator, bool>
     insert(const value_type &);
 
@@ -240,7 +248,14 @@ namespace __detail {
     void bst_impl<tkey, tvalue, compare, SPL_TAG>::delete_node(
             binary_search_tree<tkey, tvalue, compare, SPL_TAG> &cont,
             binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node *node) {
-        cont._allocator.delete_object(node);
+        destroy_node(cont._allocator, node);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::destroy_node(
+            pp_allocator<typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::value_type> &alloc,
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node *node) {
+        alloc.delete_object(node);
     }
 
     template<typename tkey, typename tvalue, typename compare>
@@ -258,13 +273,20 @@ namespace __detail {
     }
 
     template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, SPL_TAG>::erase(
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::unlink(
             binary_search_tree<tkey, tvalue, compare, SPL_TAG> &cont,
             binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node **node_ptr) {
         auto n = *node_ptr;
+        if (n == nullptr) {
+            throw std::out_of_range("Incorrect iterator for erase\n");
+        }
+
+        auto next = binary_search_tree<tkey, tvalue, compare, SPL_TAG>::get_next_infix(n);
         auto &spl = dynamic_cast<splay_tree<tkey, tvalue, compare> &>(cont);
         spl.splay(n);
         cont._root = spl.merge(n->left_subtree, n->right_subtree);
+        cont._size--;
+        *node_ptr = next;
     }
 
     template<typename tkey, typename tvalue, typename compare>
@@ -327,6 +349,14 @@ binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG>::node *
 splay_tree<tkey, tvalue, compare>::merge(binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG>::node *t1,
                                          binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG>::node *t2) {
     using node = binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG>::node;
+    // Both may still point to a node being removed
+    if (t1 != nullptr) {
+        t1->parent = nullptr;
+    }
+    if (t2 != nullptr) {
+        t2->parent = nullptr;
+    }
+
     if (t1 == nullptr) {
         return t2;
     }
@@ -334,19 +364,15 @@ splay_tree<tkey, tvalue, compare>::merge(binary_search_tree<tkey, tvalue, compar
         return t1;
     }
 
-    t1->parent = nullptr;
-    t2->parent = nullptr;
-
-    node *prev = t1;
     node *mx = t1;
     while (mx->right_subtree) {
         mx = mx->right_subtree;
-        prev = mx;
     }
+    // The greatest node of t1 becomes its root and has no right subtree
     splay(mx);
-    prev->right_subtree = t2;
-    t2->parent = prev;
-    return t1;
+    mx->right_subtree = t2;
+    t2->parent = mx;
+    return mx;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -521,6 +521,72 @@ TEST(splayTreePositiveTests, test10)
     logger->trace("splayTreePositiveTests.test10 finished");
 }
 
+TEST(splayTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger (create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  {
+                                                                          "splay_tree_tests_logs.txt",
+                                                                          logger::severity::trace
+                                                                  },
+                                                          }));
+
+    logger->trace("splayTreePositiveTests.test11 started");
+
+    auto splay1 = std::make_unique<splay_tree<int, std::string>>(std::less<int>(), nullptr, logger.get());
+    auto splay2 = std::make_unique<splay_tree<int, std::string>>(std::less<int>(), nullptr, logger.get());
+
+    for (int i = 0; i < 10; ++i)
+    {
+        splay1->emplace(i, std::to_string(i));
+    }
+    splay2->emplace(3, "x");
+    splay2->emplace(20, "y");
+
+    // The smallest key has no left subtree, the greatest no right one
+    auto first = splay1->extract(0);
+    auto last = splay1->extract(9);
+    EXPECT_EQ(first.key(), 0);
+    EXPECT_EQ(last.mapped(), "9");
+    EXPECT_TRUE(splay1->extract(42).empty());
+
+    std::vector<int> keys;
+    for (auto const &item: *splay1)
+    {
+        keys.push_back(item.first);
+    }
+    EXPECT_EQ(keys, (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8}));
+
+    EXPECT_TRUE(splay2->insert(std::move(first)).inserted);
+    auto refused = splay2->insert(splay1->extract(3));
+    EXPECT_FALSE(refused.inserted);
+    EXPECT_EQ(refused.position->second, "x");
+    EXPECT_TRUE(splay1->insert(std::move(refused.node)).inserted);
+
+    splay2->merge(*splay1);
+
+    std::vector<typename splay_tree<int, std::string>::value_type> expected_result =
+        {
+            { 0, "0" },
+            { 1, "1" },
+            { 2, "2" },
+            { 3, "x" },
+            { 4, "4" },
+            { 5, "5" },
+            { 6, "6" },
+            { 7, "7" },
+            { 8, "8" },
+            { 20, "y" }
+        };
+    std::vector<typename splay_tree<int, std::string>::value_type> actual_result(splay2->begin(), splay2->end());
+
+    EXPECT_TRUE(compare_results(expected_result, actual_result));
+    EXPECT_EQ(splay1->size(), 1);
+    EXPECT_EQ(splay1->begin()->second, "3");
+
+    logger->trace("splayTreePositiveTests.test11 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -4,6 +4,7 @@
 #include <client_logger_builder.h>
 #include <allocator_sorted_list.h>
 #include <iostream>
+#include <string_view>
 
 logger *create_logger(
     std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -545,6 +546,99 @@ TEST(binarySearchTreePositiveTests, test10)
 }
 
 
+TEST(binarySearchTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test11 started");
+    
+    auto bst1 = std::make_unique<binary_search_tree<int, std::string>>(std::less<int>(), nullptr, logger.get());
+    auto bst2 = std::make_unique<binary_search_tree<int, std::string>>(std::less<int>(), nullptr, logger.get());
+    
+    bst1->emplace(6, "l");
+    bst1->emplace(8, "c");
+    bst1->emplace(15, "l");
+    bst1->emplace(11, "o");
+    bst1->emplace(9, "h");
+    bst1->emplace(2, "e");
+    bst1->emplace(4, "b");
+    bst1->emplace(18, "e");
+    
+    bst2->emplace(5, "a");
+    bst2->emplace(7, "d");
+    bst2->emplace(9, "x");
+    
+    auto node = bst1->extract(6);
+    
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+            test_data<int, std::string>(1, 2, "e"),
+            test_data<int, std::string>(0, 4, "b"),
+            test_data<int, std::string>(1, 8, "c"),
+            test_data<int, std::string>(4, 9, "h"),
+            test_data<int, std::string>(3, 11, "o"),
+            test_data<int, std::string>(2, 15, "l"),
+            test_data<int, std::string>(3, 18, "e")
+        };
+    
+    EXPECT_TRUE(infix_iterator_test(*bst1, expected_result));
+    EXPECT_EQ(node.key(), 6);
+    EXPECT_TRUE(bst2->insert(std::move(node)).inserted);
+    
+    bst2->merge(*bst1);
+    
+    std::vector<int> merged;
+    for (auto const &item: *bst2)
+    {
+        merged.push_back(item.first);
+    }
+    
+    EXPECT_EQ(merged, (std::vector<int>{2, 4, 5, 6, 7, 8, 9, 11, 15, 18}));
+    EXPECT_EQ(bst1->size(), 1);
+    EXPECT_EQ(bst1->begin()->second, "h");
+    
+    logger->trace("binarySearchTreePositiveTests.test11 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test12)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test12 started");
+    
+    binary_search_tree<std::string, int, std::less<>> bst(std::less<>(), nullptr, logger.get());
+    
+    bst.emplace("delta", 4);
+    bst.emplace("alpha", 1);
+    bst.emplace("echo", 5);
+    bst.emplace("charlie", 3);
+    bst.emplace("bravo", 2);
+    
+    std::string_view key = "charlie";
+    
+    EXPECT_EQ(bst.find(key)->second, 3);
+    EXPECT_EQ(bst.find("charles"), bst.end());
+    EXPECT_TRUE(bst.contains(key));
+    EXPECT_FALSE(bst.contains("foxtrot"));
+    EXPECT_EQ(bst.at("echo"), 5);
+    EXPECT_THROW(bst.at("zulu"), std::out_of_range);
+    EXPECT_EQ(bst.lower_bound("c")->second, 3);
+    EXPECT_EQ(bst.upper_bound(key)->second, 4);
+    EXPECT_EQ(bst.upper_bound("echo"), bst.end());
+    
+    logger->trace("binarySearchTreePositiveTests.test12 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -27,6 +27,10 @@ private:
     // region comparators declaration
 
     inline bool compare_keys(const tkey& lhs, const tkey& rhs) const;
+
+    // Against a lookup key of another type, which only a transparent compare takes
+    template<typename lhs_t, typename rhs_t>
+    inline bool compare_keys(const lhs_t& lhs, const rhs_t& rhs) const;
     inline bool compare_pairs(const tree_data_type& lhs, const tree_data_type& rhs) const;
 
     // endregion comparators declaration
@@ -331,6 +335,52 @@ public:
 
     bool contains(const tkey& key) const;
 
+    /*
+     * Same lookups by any type compare orders against tkey, only for a compare declaring is_transparent
+     */
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    tvalue& at(const K& key);
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    const tvalue& at(const K& key) const;
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    btree_iterator find(const K& key);
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    btree_const_iterator find(const K& key) const;
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    btree_iterator lower_bound(const K& key);
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    btree_const_iterator lower_bound(const K& key) const;
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    btree_iterator upper_bound(const K& key);
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    btree_const_iterator upper_bound(const K& key) const;
+
+    template<typename K> requires transparent_compator<compare, K, tkey>
+    bool contains(const K& key) const;
+
+private:
+
+    // Iterator to the first key not less than key (greater for upper), not_found if there is none
+    template<typename iterator, typename K>
+    iterator bound(const K& key, bool upper, iterator not_found) const;
+
+    template<typename iterator, typename K>
+    iterator find_key(const K& key, iterator not_found) const;
+
+    // Element with key or nullptr, builds no path
+    template<typename K>
+    tree_data_type* find_data(const K& key) const;
+
+public:
+
     // endregion lookup declaration
 
     // region modifiers declaration
@@ -398,6 +448,13 @@ bool B_tree<tkey, tvalue, compare, t>::compare_keys(const tkey &lhs, const tkey
     return compare::operator()(lhs, rhs);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename lhs_t, typename rhs_t>
+bool B_tree<tkey, tvalue, compare, t>::compare_keys(const lhs_t &lhs, const rhs_t &rhs) const
+{
+    return compare::operator()(lhs, rhs);
+}
+
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 B_tree<tkey, tvalue, compare, t>::btree_node::btree_node() noexcept : _keys(), _pointers()
@@ -1023,21 +1080,43 @@ size_t B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::index() c
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 tvalue& B_tree<tkey, tvalue, compare, t>::at(const tkey& key)
 {
-    auto it = find(key);
-    if (it == end()){
+    auto data = find_data(key);
+    if (data == nullptr){
         throw std::out_of_range("incorrect key for at");
     }
-    return it->second;
+    return data->second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 const tvalue& B_tree<tkey, tvalue, compare, t>::at(const tkey& key) const
 {
-    auto it = find(key);
-    if (it._path.empty()){
+    auto data = find_data(key);
+    if (data == nullptr){
         throw std::out_of_range("incorrect key for at");
     }
-    return it->second;
+    return data->second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compator<compare, K, tkey>
+tvalue& B_tree<tkey, tvalue, compare, t>::at(const K& key)
+{
+    auto data = find_data(key);
+    if (data == nullptr){
+        throw std::out_of_range("incorrect key for at");
+    }
+    return data->second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compator<compare, K, tkey>
+const tvalue& B_tree<tkey, tvalue, compare, t>::at(const K& key) const
+{
+    auto data = find_data(key);
+    if (data == nullptr){
+        throw std::out_of_range("incorrect key for at");
+    }
+    return data->second;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
@@ -1214,150 +1293,158 @@ bool B_tree<tkey, tvalue, compare, t>::empty() const noexcept
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key)
 {
-    size_t i = 0;
-    size_t prev_i = 0;
-    auto cur_node = _root;
-    auto cur_key = _root->_keys[i];
-    std::stack<std::pair<btree_node*, size_t>> st = std::stack<std::pair<btree_node*, size_t>>();
-    st.push(std::pair<btree_node*, size_t>(_root, 0));
-    while(cur_node != nullptr){
-        i = 0;
-        for(; i < cur_node->_keys.size() && compare_keys(cur_node->_keys[i].first, key); i++){}
-        st.push(std::pair<btree_node*, size_t>(cur_node, prev_i));
-        if (i < cur_node->_keys.size() && cur_node->_keys[i].first == key){
-            return btree_iterator(st, i);
-        }
-
-        cur_node = cur_node->_pointers[i];
-        prev_i = i;
-    }
-    return end();
+    return find_key(key, end());
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key) const
 {
-    size_t i = 0;
-    size_t prev_i = 0;
-    auto cur_node = _root;
-    auto cur_key = _root->_keys[i];
-    std::stack<std::pair<btree_node**, size_t>> st = std::stack<std::pair<btree_node**, size_t>>();
-    st.push(std::pair<btree_node**, size_t>(&_root, 0));
-    while(cur_node != nullptr){
-        i = 0;
-        for(; i < cur_node->_keys.size() && compare_keys(cur_node->_keys[i].first, key); i++){}
-        st.push(std::pair<btree_node*, size_t>(cur_node, prev_i));
-        if (i < cur_node->_keys.size() && cur_node->_keys[i].first == key){
-            break;
-        }
-
-        cur_node = cur_node->_pointers[i];
-        prev_i = i;
-    }
-    return btree_iterator(st, i);
+    return find_key(key, end());
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key)
 {
-    size_t i = 0;
-    size_t prev_i = 0;
-    auto cur_node = _root;
-    std::stack<std::pair<btree_node*, size_t>> st = std::stack<std::pair<btree_node*, size_t>>();
-    st.push(std::pair<btree_node*, size_t>(_root, 0));
-    while(cur_node != nullptr){
-        i = 0;
-        for(; i < cur_node->_keys.size() && compare_keys(cur_node->_keys[i].first, key); i++){}
-        st.push(std::pair<btree_node*, size_t>(cur_node, prev_i));
-        cur_node = cur_node->_pointers[i];
-        prev_i = i;
-    }
-    if (st.size() == 1 && i == st.top().first->_keys.size()){
-        return end();
-    } else {
-        //сейчас в st хранится путь до nullptr. Удаляем последний элемент, чтобы путь был до ноды, а не до nullptr
-        st.pop();
-        return btree_iterator(st, prev_i);
-    }
+    return bound(key, false, end());
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) const
 {
-    size_t i = 0;
-    size_t prev_i = 0;
-    auto cur_node = _root;
-    std::stack<std::pair<btree_node*, size_t>> st = std::stack<std::pair<btree_node*, size_t>>();
-    st.push(std::pair<btree_node*, size_t>(_root, 0));
-    while(cur_node != nullptr){
-        i = 0;
-        for(; i < cur_node->_keys.size() && compare_keys(cur_node->_keys[i].first, key); i++){}
-        st.push(std::pair<btree_node*, size_t>(cur_node, prev_i));
-        cur_node = cur_node->_pointers[i];
-        prev_i = i;
-    }
-    if (st.size() == 1 && i == st.top().first->_keys.size()){
-        return cend();
-    } else {
-        //сейчас в st хранится путь до nullptr. Удаляем последний элемент, чтобы путь был до ноды, а не до nullptr
-        st.pop();
-        return btree_const_iterator(st, prev_i);
-    }
+    return bound(key, false, end());
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key)
 {
-    size_t i = 0;
-    size_t prev_i = 0;
-    auto cur_node = _root;
-    std::stack<std::pair<btree_node*, size_t>> st = std::stack<std::pair<btree_node*, size_t>>();
-    st.push(std::pair<btree_node*, size_t>(_root, 0));
-    while(cur_node != nullptr){
-        i = 0;
-        for(; i < cur_node->_keys.size() && !compare_keys(key, cur_node->_keys[i].first); i++){}
-        st.push(std::pair<btree_node*, size_t>(cur_node, prev_i));
-        cur_node = cur_node->_pointers[i];
-        prev_i = i;
-    }
-    if (st.size() == 1 && i == st.top().first->_keys.size()){
-        return end();
-    } else {
-        //сейчас в st хранится путь до nullptr. Удаляем последний элемент, чтобы путь был до ноды, а не до nullptr
-        st.pop();
-        return btree_iterator(st, prev_i);
-    }
+    return bound(key, true, end());
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
 typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) const
 {
-    size_t i = 0;
-    size_t prev_i = 0;
-    auto cur_node = _root;
-    std::stack<std::pair<btree_node*, size_t>> st = std::stack<std::pair<btree_node*, size_t>>();
-    st.push(std::pair<btree_node*, size_t>(_root, 0));
-    while(cur_node != nullptr){
-        i = 0;
-        for(; i < cur_node->_keys.size() && !compare_keys(key, cur_node->_keys[i].first); i++){}
-        st.push(std::pair<btree_node*, size_t>(cur_node, prev_i));
-        cur_node = cur_node->_pointers[i];
-        prev_i = i;
+    return bound(key, true, end());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+bool B_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const
+{
+    return find_data(key) != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::find(const K& key)
+{
+    return find_key(key, end());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::find(const K& key) const
+{
+    return find_key(key, end());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const K& key)
+{
+    return bound(key, false, end());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const K& key) const
+{
+    return bound(key, false, end());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const K& key)
+{
+    return bound(key, true, end());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compator<compare, K, tkey>
+typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const K& key) const
+{
+    return bound(key, true, end());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K> requires transparent_compator<compare, K, tkey>
+bool B_tree<tkey, tvalue, compare, t>::contains(const K& key) const
+{
+    return find_data(key) != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename iterator, typename K>
+iterator B_tree<tkey, tvalue, compare, t>::bound(const K& key, bool upper, iterator not_found) const
+{
+    // The bound is the last key met on the way down that is not less than key, deeper ones are smaller
+    decltype(iterator::_path) path;
+    size_t found_depth = 0;
+    size_t found_index = 0;
+    size_t index_in_parent = 0;
+    for (btree_node* cur_node = _root; cur_node != nullptr;)
+    {
+        size_t i = 0;
+        for(; i < cur_node->_keys.size() && (upper ? !compare_keys(key, cur_node->_keys[i].first)
+                                                   : compare_keys(cur_node->_keys[i].first, key)); i++){}
+        path.push(std::pair(cur_node, index_in_parent));
+
+        if (i < cur_node->_keys.size())
+        {
+            found_depth = path.size();
+            found_index = i;
+            if (!upper && !compare_keys(key, cur_node->_keys[i].first))
+            {
+                break;
+            }
+        }
+
+        cur_node = i < cur_node->_pointers.size() ? cur_node->_pointers[i] : nullptr;
+        index_in_parent = i;
     }
-    if (st.size() == 1 && i == st.top().first->_keys.size()){
-        return end();
-    } else {
-        //сейчас в st хранится путь до nullptr. Удаляем последний элемент, чтобы путь был до ноды, а не до nullptr
-        st.pop();
-        return btree_const_iterator(st, prev_i);
+
+    if (found_depth == 0)
+    {
+        return not_found;
     }
+    while (path.size() > found_depth)
+    {
+        path.pop();
+    }
+    return iterator(path, found_index);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const
+template<typename iterator, typename K>
+iterator B_tree<tkey, tvalue, compare, t>::find_key(const K& key, iterator not_found) const
 {
-    auto it = find(key);
-    return it != end();
+    auto it = bound(key, false, not_found);
+    return it == not_found || compare_keys(key, it->first) ? not_found : it;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename K>
+typename B_tree<tkey, tvalue, compare, t>::tree_data_type* B_tree<tkey, tvalue, compare, t>::find_data(const K& key) const
+{
+    for (btree_node* cur_node = _root; cur_node != nullptr;)
+    {
+        size_t i = 0;
+        for(; i < cur_node->_keys.size() && compare_keys(cur_node->_keys[i].first, key); i++){}
+        if (i < cur_node->_keys.size() && !compare_keys(key, cur_node->_keys[i].first))
+        {
+            return &cur_node->_keys[i];
+        }
+        cur_node = i < cur_node->_pointers.size() ? cur_node->_pointers[i] : nullptr;
+    }
+    return nullptr;
 }
 
 // endregion lookup implementation
@@ -2,6 +2,7 @@
 
 #include <list>
 #include <random>
+#include <string_view>
 #include <vector>
 #include <b_tree.h>
 #include <client_logger_builder.h>
@@ -596,6 +597,52 @@ TEST(bTreeNegativeTests, test3)
     logger->trace("bTreeNegativeTests.test3 finished");
 }
 
+TEST(bTreePositiveTests, test10)
+{
+    std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  { "b_tree_tests_logs.txt", logger::severity::trace }
+                                                          }));
+
+    logger->trace("bTreePositiveTests.test10 started");
+
+    B_tree<std::string, int, std::less<>, 3> tree(std::less<>(), nullptr, logger.get());
+
+    for (int i = 0; i < 16; ++i)
+    {
+        tree.emplace("key " + std::to_string(100 + i), i);
+    }
+
+    std::string_view key = "key 110";
+
+    EXPECT_EQ(tree.find(key)->second, 10);
+    EXPECT_EQ(tree.find("key 1100"), tree.end());
+    EXPECT_TRUE(tree.contains(key));
+    EXPECT_FALSE(tree.contains("key 1100"));
+    EXPECT_EQ(tree.at("key 115"), 15);
+    EXPECT_THROW(tree.at("key 200"), std::out_of_range);
+    EXPECT_EQ(tree.lower_bound("key 1100")->second, 11);
+    EXPECT_EQ(tree.upper_bound(key)->second, 11);
+    EXPECT_EQ(tree.lower_bound("key 2"), tree.end());
+
+    // Keys of inner nodes and leaves alike
+    for (int i = 0; i < 16; ++i)
+    {
+        std::string stored = "key " + std::to_string(100 + i);
+        EXPECT_EQ(tree.find(std::string_view(stored))->second, i);
+        EXPECT_EQ(tree.lower_bound(std::string_view(stored))->second, i);
+        auto upper = tree.upper_bound(std::string_view(stored));
+        EXPECT_TRUE(i == 15 ? upper == tree.end() : upper->second == i + 1);
+    }
+
+    auto const &view = tree;
+    EXPECT_EQ(view.find(key)->second, 10);
+    EXPECT_EQ(view.at(key), 10);
+    EXPECT_EQ(view.lower_bound("key 1")->second, 0);
+
+    logger->trace("bTreePositiveTests.test10 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -0,0 +1,141 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_COMMON_FORK_JOIN_POOL_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_COMMON_FORK_JOIN_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Work stealing pool for fork/join recursion. A fork pushes its second half to the bottom of the
+// forking thread's own deque and runs the first half in place; idle workers steal from the top of
+// the other deques, where the largest pending pieces of a recursion sit. A thread waiting for a
+// join runs other pending tasks meanwhile, so nested forks never block a worker.
+class fork_join_pool final
+{
+
+public:
+
+    class task
+    {
+
+        friend fork_join_pool;
+
+        std::atomic<bool> _done{false};
+
+        std::exception_ptr _error;
+
+    protected:
+
+        virtual void execute() = 0;
+
+        ~task() noexcept = default;
+
+    public:
+
+        void run() noexcept;
+
+        [[nodiscard]] bool done() const noexcept;
+
+    };
+
+private:
+
+    struct task_deque
+    {
+        std::mutex lock;
+
+        std::deque<task *> tasks;
+    };
+
+    // One per worker, the last one is shared by threads outside the pool
+    std::vector<std::unique_ptr<task_deque>> _deques;
+
+    std::vector<std::thread> _workers;
+
+    std::atomic<size_t> _queued{0};
+
+    std::atomic<bool> _stop{false};
+
+    std::mutex _idle_lock;
+
+    std::condition_variable _idle;
+
+    size_t own_deque() const noexcept;
+
+    void push(task *work);
+
+    // Own deque from the bottom, then the others from the top; nullptr if all are empty
+    task *take(size_t own);
+
+    void work(size_t index);
+
+    void wait_for(task &work);
+
+public:
+
+    // threads == 0 starts one worker per hardware thread
+    explicit fork_join_pool(size_t threads = 0);
+
+    fork_join_pool(fork_join_pool const &) = delete;
+    fork_join_pool &operator=(fork_join_pool const &) = delete;
+
+    ~fork_join_pool() noexcept;
+
+    [[nodiscard]] size_t concurrency() const noexcept;
+
+    // Runs both, possibly in parallel, and returns once both finished; rethrows an exception of either
+    template<typename first_body, typename second_body>
+    void fork_join(first_body &&first, second_body &&second);
+
+    // One worker per hardware thread, started on first use
+    static fork_join_pool &shared();
+
+};
+
+template<typename first_body, typename second_body>
+void fork_join_pool::fork_join(first_body &&first, second_body &&second)
+{
+    struct deferred final : task
+    {
+        std::remove_reference_t<second_body> &body;
+
+        explicit deferred(std::remove_reference_t<second_body> &body) : body(body) {}
+
+        void execute() override
+        {
+            body();
+        }
+    } pending(second);
+
+    push(&pending);
+
+    std::exception_ptr error;
+    try
+    {
+        first();
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    // pending lives on this frame, so it is waited for even if first threw
+    wait_for(pending);
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    if (pending._error)
+    {
+        std::rethrow_exception(pending._error);
+    }
+}
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_COMMON_FORK_JOIN_POOL_H
@@ -0,0 +1,178 @@
+#include "../include/fork_join_pool.h"
+#include <algorithm>
+
+namespace
+{
+    // Pool the current thread works for and its deque there
+    thread_local fork_join_pool const *current_pool = nullptr;
+
+    thread_local size_t current_deque = 0;
+}
+
+void fork_join_pool::task::run() noexcept
+{
+    try
+    {
+        execute();
+    }
+    catch (...)
+    {
+        _error = std::current_exception();
+    }
+
+    _done.store(true, std::memory_order_release);
+}
+
+bool fork_join_pool::task::done() const noexcept
+{
+    return _done.load(std::memory_order_acquire);
+}
+
+fork_join_pool::fork_join_pool(
+    size_t threads)
+{
+    if (threads == 0)
+    {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    for (size_t i = 0; i <= threads; ++i)
+    {
+        _deques.push_back(std::make_unique<task_deque>());
+    }
+
+    _workers.reserve(threads);
+    for (size_t i = 0; i < threads; ++i)
+    {
+        _workers.emplace_back(&fork_join_pool::work, this, i);
+    }
+}
+
+fork_join_pool::~fork_join_pool() noexcept
+{
+    {
+        std::lock_guard guard(_idle_lock);
+        _stop = true;
+    }
+    _idle.notify_all();
+
+    for (auto &worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+size_t fork_join_pool::concurrency() const noexcept
+{
+    return _workers.size();
+}
+
+fork_join_pool &fork_join_pool::shared()
+{
+    static fork_join_pool pool;
+    return pool;
+}
+
+size_t fork_join_pool::own_deque() const noexcept
+{
+    return current_pool == this ? current_deque : _deques.size() - 1;
+}
+
+void fork_join_pool::push(
+    task *work)
+{
+    auto &own = *_deques[own_deque()];
+    {
+        std::lock_guard guard(own.lock);
+        own.tasks.push_back(work);
+    }
+
+    _queued.fetch_add(1, std::memory_order_release);
+    {
+        // Empty critical section orders the push before a worker's check of _queued
+        std::lock_guard guard(_idle_lock);
+    }
+    _idle.notify_one();
+}
+
+fork_join_pool::task *fork_join_pool::take(
+    size_t own)
+{
+    if (_queued.load(std::memory_order_acquire) == 0)
+    {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < _deques.size(); ++i)
+    {
+        auto &victim = *_deques[(own + i) % _deques.size()];
+        std::lock_guard guard(victim.lock);
+
+        if (victim.tasks.empty())
+        {
+            continue;
+        }
+
+        task *work;
+        if (i == 0)
+        {
+            work = victim.tasks.back();
+            victim.tasks.pop_back();
+        }
+        else
+        {
+            work = victim.tasks.front();
+            victim.tasks.pop_front();
+        }
+
+        _queued.fetch_sub(1, std::memory_order_relaxed);
+        return work;
+    }
+
+    return nullptr;
+}
+
+void fork_join_pool::work(
+    size_t index)
+{
+    current_pool = this;
+    current_deque = index;
+
+    while (true)
+    {
+        if (task *work = take(index))
+        {
+            work->run();
+            continue;
+        }
+
+        std::unique_lock lock(_idle_lock);
+        _idle.wait(lock, [this]
+        {
+            return _stop || _queued.load(std::memory_order_acquire) != 0;
+        });
+
+        if (_stop)
+        {
+            return;
+        }
+    }
+}
+
+void fork_join_pool::wait_for(
+    task &work)
+{
+    size_t own = own_deque();
+
+    while (!work.done())
+    {
+        if (task *other = take(own))
+        {
+            other->run();
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,398 @@
+// Throughput and per-call latency of the loggers.
+//
+// usage: mp_os_lggr_bnchmrk [--messages N] [--threads 1,2,4] [--filter substring]
+//
+// Every producer thread builds its own logger from the scenario and logs N messages, the reported
+// rate includes the final flush. Results go to stderr, so console scenarios are best run with stdout
+// redirected to /dev/null. server_logger scenarios talk to a stand-in server started in this process
+// that accepts and discards everything.
+
+#include <client_logger_builder.h>
+#include <server_logger_builder.h>
+#include <binary_logger_builder.h>
+#include <httplib.h>
+
+#include <algorithm>
+#include <barrier>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace
+{
+    using clock_type = std::chrono::steady_clock;
+
+    struct scenario
+    {
+        std::string name;
+
+        // loggers that can not do many calls per second get fewer messages
+        size_t messages_divisor;
+
+        std::function<std::unique_ptr<logger>(size_t thread_index)> make;
+
+        std::function<void(logger&, size_t i)> emit;
+    };
+
+    struct result
+    {
+        double messages_per_second;
+
+        std::chrono::nanoseconds p50;
+
+        std::chrono::nanoseconds p99;
+    };
+
+    void emit_string(logger& log, size_t i)
+    {
+        log.trace("benchmark message number " + std::to_string(i));
+    }
+
+    void emit_fields(logger& log, size_t i)
+    {
+        log.log(logger::severity::trace, "benchmark message", {{"number", i}});
+    }
+
+    void emit_binary(logger& log, size_t i)
+    {
+        static_cast<binary_logger&>(log).log_format(logger::severity::trace, "benchmark message number {}", i);
+    }
+
+    result run(scenario const& bench, size_t threads_count, size_t messages)
+    {
+        std::vector<std::vector<std::chrono::nanoseconds>> latencies(threads_count);
+        std::vector<std::exception_ptr> errors(threads_count);
+        std::barrier start(static_cast<std::ptrdiff_t>(threads_count + 1));
+        std::barrier built(static_cast<std::ptrdiff_t>(threads_count + 1));
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < threads_count; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                std::unique_ptr<logger> log;
+                try
+                {
+                    log = bench.make(t);
+                }
+                catch (...)
+                {
+                    errors[t] = std::current_exception();
+                }
+
+                auto& own = latencies[t];
+                own.reserve(messages);
+
+                built.arrive_and_wait();
+                start.arrive_and_wait();
+
+                try
+                {
+                    for (size_t i = 0; log && i < messages; ++i)
+                    {
+                        auto before = clock_type::now();
+                        bench.emit(*log, i);
+                        own.push_back(clock_type::now() - before);
+                    }
+
+                    if (log)
+                    {
+                        log->flush();
+                    }
+                }
+                catch (...)
+                {
+                    errors[t] = std::current_exception();
+                }
+            });
+        }
+
+        // Opening files and /init requests are not measured
+        built.arrive_and_wait();
+        auto began = clock_type::now();
+        start.arrive_and_wait();
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        auto elapsed = std::chrono::duration<double>(clock_type::now() - began);
+
+        for (auto& error : errors)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        std::vector<std::chrono::nanoseconds> all;
+        all.reserve(threads_count * messages);
+        for (auto& own : latencies)
+        {
+            all.insert(all.end(), own.begin(), own.end());
+        }
+
+        auto percentile = [&all](double fraction)
+        {
+            auto nth = all.begin() + static_cast<std::ptrdiff_t>(fraction * static_cast<double>(all.size() - 1));
+            std::nth_element(all.begin(), nth, all.end());
+            return *nth;
+        };
+
+        return {static_cast<double>(all.size()) / elapsed.count(), percentile(0.5), percentile(0.99)};
+    }
+
+    // Accepts every server_logger request over HTTP and, where available, over a unix datagram socket
+    class stand_in_server
+    {
+        httplib::Server _http;
+
+        int _port;
+
+        std::thread _http_worker;
+
+        std::string _unix_path;
+
+        int _unix_fd = -1;
+
+        std::thread _unix_worker;
+
+    public:
+
+        stand_in_server()
+        {
+            auto accept = [](const httplib::Request&, httplib::Response& res)
+            {
+                res.status = httplib::NoContent_204;
+            };
+            _http.Get("/init", accept);
+            _http.Get("/destroy", accept);
+            _http.Get("/log", accept);
+            _http.Post("/log_batch", accept);
+
+            _port = _http.bind_to_any_port("127.0.0.1");
+            _http_worker = std::thread([this] { _http.listen_after_bind(); });
+            _http.wait_until_ready();
+
+#ifndef _WIN32
+            _unix_path = (std::filesystem::temp_directory_path() / "mp_os_lggr_bnchmrk.sock").string();
+            ::unlink(_unix_path.c_str());
+
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, _unix_path.c_str(), sizeof(address.sun_path) - 1);
+
+            _unix_fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+            if (_unix_fd == -1 || ::bind(_unix_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+            {
+                throw std::runtime_error("Failed to bind " + _unix_path);
+            }
+
+            _unix_worker = std::thread([this]
+            {
+                std::vector<char> buffer(server_logger::max_datagram_size);
+                while (::recv(_unix_fd, buffer.data(), buffer.size(), 0) > 0)
+                {
+                }
+            });
+#endif
+        }
+
+        stand_in_server(const stand_in_server&) = delete;
+        stand_in_server& operator=(const stand_in_server&) = delete;
+
+        ~stand_in_server() noexcept
+        {
+            _http.stop();
+            _http_worker.join();
+
+#ifndef _WIN32
+            ::shutdown(_unix_fd, SHUT_RDWR);
+            _unix_worker.join();
+            ::close(_unix_fd);
+            ::unlink(_unix_path.c_str());
+#endif
+        }
+
+        [[nodiscard]] std::string http_destination() const
+        {
+            return "http://127.0.0.1:" + std::to_string(_port);
+        }
+
+        [[nodiscard]] std::string const& unix_path() const noexcept
+        {
+            return _unix_path;
+        }
+    };
+
+    std::vector<scenario> make_scenarios(std::filesystem::path const& directory, stand_in_server const& server)
+    {
+        std::string shared_file = (directory / "shared.log").string();
+
+        auto client = [shared_file](std::string format, size_t flush_bytes)
+        {
+            return [shared_file, format, flush_bytes](size_t)
+            {
+                client_logger_builder builder;
+                builder.set_flush_bytes(flush_bytes).set_format(format)
+                        .add_file_stream(shared_file, logger::severity::trace);
+                return std::unique_ptr<logger>(builder.build());
+            };
+        };
+
+        std::vector<scenario> scenarios;
+
+        // flush_bytes == 0 flushes every record, as client_logger did before buffering
+        for (auto [format_name, format] : {std::pair{"plain", "%m"}, std::pair{"datetime", "[%d %t][%s] %m"}})
+        {
+            scenarios.push_back({std::string("client/file/unbuffered/") + format_name, 1,
+                                 client(format, 0), emit_string});
+            scenarios.push_back({std::string("client/file/buffered/") + format_name, 1,
+                                 client(format, 64 * 1024), emit_string});
+        }
+
+        scenarios.push_back({"client/file/buffered/fields", 1, client("[%d %t][%s] %m", 64 * 1024), emit_fields});
+
+        scenarios.push_back({"client/three_files/buffered", 1, [directory](size_t)
+        {
+            client_logger_builder builder;
+            builder.set_format("[%d %t][%s] %m");
+            for (auto name : {"first.log", "second.log", "third.log"})
+            {
+                builder.add_file_stream((directory / name).string(), logger::severity::trace);
+            }
+            return std::unique_ptr<logger>(builder.build());
+        }, emit_string});
+
+        scenarios.push_back({"client/console", 1, [](size_t)
+        {
+            client_logger_builder builder;
+            builder.set_format("[%d %t][%s] %m").add_console_stream(logger::severity::trace);
+            return std::unique_ptr<logger>(builder.build());
+        }, emit_string});
+
+        scenarios.push_back({"binary/file", 1, [directory](size_t)
+        {
+            binary_logger_builder builder;
+            builder.add_file_stream((directory / "binary.log").string(), logger::severity::trace);
+            return std::unique_ptr<logger>(builder.build());
+        }, emit_binary});
+
+        auto remote = [](std::string destination, size_t batch)
+        {
+            return [destination, batch](size_t)
+            {
+                server_logger_builder builder;
+                builder.set_destination(destination);
+                builder.set_batching(batch, std::chrono::milliseconds(50));
+                builder.add_file_stream("benchmark.log", logger::severity::trace);
+                return std::unique_ptr<logger>(builder.build());
+            };
+        };
+
+        scenarios.push_back({"server/http/unbatched", 20, remote(server.http_destination(), 0), emit_string});
+        scenarios.push_back({"server/http/batched", 1, remote(server.http_destination(), 256), emit_string});
+
+#ifndef _WIN32
+        scenarios.push_back({"server/unix", 1,
+                             remote(std::string(server_logger::unix_scheme) + server.unix_path(), 0), emit_string});
+#endif
+
+        return scenarios;
+    }
+
+    std::vector<size_t> parse_list(std::string const& list)
+    {
+        std::vector<size_t> values;
+        std::stringstream stream(list);
+        std::string value;
+
+        while (std::getline(stream, value, ','))
+        {
+            values.push_back(std::stoul(value));
+        }
+
+        return values;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t messages = 20000;
+    std::vector<size_t> threads = {1, 2, 4, 8, 16, 32};
+    std::string filter;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string option = argv[i];
+
+        if (option == "--messages")
+        {
+            messages = std::stoul(argv[i + 1]);
+        }
+        else if (option == "--threads")
+        {
+            threads = parse_list(argv[i + 1]);
+        }
+        else if (option == "--filter")
+        {
+            filter = argv[i + 1];
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--messages N] [--threads 1,2,4] [--filter substring]" << std::endl;
+            return 1;
+        }
+    }
+
+    auto directory = std::filesystem::temp_directory_path() / "mp_os_lggr_bnchmrk";
+    std::filesystem::create_directories(directory);
+
+    stand_in_server server;
+
+    std::fprintf(stderr, "%-32s %8s %14s %10s %10s\n", "scenario", "threads", "messages/s", "p50 ns", "p99 ns");
+
+    for (auto const& bench : make_scenarios(directory, server))
+    {
+        if (bench.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        for (size_t threads_count : threads)
+        {
+            try
+            {
+                auto measured = run(bench, threads_count, std::max<size_t>(messages / bench.messages_divisor, 1));
+                std::fprintf(stderr, "%-32s %8zu %14.0f %10lld %10lld\n", bench.name.c_str(), threads_count,
+                             measured.messages_per_second, static_cast<long long>(measured.p50.count()),
+                             static_cast<long long>(measured.p99.count()));
+            }
+            catch (std::exception const& e)
+            {
+                std::fprintf(stderr, "%-32s %8zu failed: %s\n", bench.name.c_str(), threads_count, e.what());
+            }
+        }
+    }
+
+    std::error_code ignored;
+    std::filesystem::remove_all(directory, ignored);
+
+    return 0;
+}
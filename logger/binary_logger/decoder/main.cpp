@@ -0,0 +1,38 @@
+#include <binary_log_decoder.h>
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <binary log> [format, \"%d %t %s %m\" by default]" << std::endl;
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in.is_open())
+    {
+        std::cerr << "Failed to open file: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        if (argc == 3)
+        {
+            binary_log_decoder::decode(in, std::cout, argv[2]);
+        }
+        else
+        {
+            binary_log_decoder::decode(in, std::cout);
+        }
+    }
+    catch (std::exception const &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
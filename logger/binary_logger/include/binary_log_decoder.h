@@ -0,0 +1,22 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOG_DECODER_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOG_DECODER_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+
+// Renders files written by binary_logger with client_logger format flags (%d %t %s %m)
+class binary_log_decoder final
+{
+
+public:
+
+    // throws std::runtime_error on a malformed or truncated input
+    static void decode(
+        std::istream &in,
+        std::ostream &out,
+        std::string const &format = "%d %t %s %m");
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOG_DECODER_H
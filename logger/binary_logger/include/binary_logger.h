@@ -0,0 +1,190 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOGGER_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOGGER_H
+
+#include <logger.h>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <forward_list>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+class binary_logger_builder;
+
+// Writes records as a format id, a timestamp and raw arguments; text is produced offline by binary_log_decoder.
+//
+// File layout (native byte order): 8 byte magic, then a sequence of
+//   'F' u32 id, u32 length, format bytes               - defines a format the first time a file sees it
+//   'R' u32 id, i64 ns since epoch, u8 severity, u8 argc, argc * (u8 arg_type, payload)
+// where payload is i64 / u64 / f64 / u8 for numbers and booleans and u32 length + bytes for strings.
+class binary_logger final:
+    public logger
+{
+public:
+
+    enum class arg_type : std::uint8_t
+    {
+        SIGNED,
+        UNSIGNED,
+        FLOATING,
+        BOOLEAN,
+        STRING
+    };
+
+    static constexpr char format_tag = 'F';
+
+    static constexpr char record_tag = 'R';
+
+    static constexpr std::string_view magic{"MPLOGB1\0", 8};
+
+private:
+    //region binary_stream
+
+    class binary_stream final
+    {
+        std::mutex _mutex;
+
+        // declared before the stream so it outlives it
+        std::unique_ptr<char[]> _buffer;
+
+        std::ofstream _stream;
+
+        // formats are keyed by address, so they have to be string literals or otherwise outlive the logger
+        std::unordered_map<char const *, std::uint32_t> _format_ids;
+
+    public:
+
+        explicit binary_stream(const std::string& path);
+
+        // body is everything of a record after the format id
+        void write(char const *format, std::string_view body, bool flush);
+
+        void flush();
+    };
+
+    //region binary_stream
+
+    //region stream_registry
+
+    // Path -> stream of every binary_logger writing it, so that loggers of one file share its writes
+    // and format table instead of truncating it for each other. A stream closes with its last logger
+    class stream_registry final
+    {
+        std::mutex _mutex;
+
+        std::unordered_map<std::string, std::weak_ptr<binary_stream>> _streams;
+
+    public:
+
+        std::shared_ptr<binary_stream> open(const std::string& path);
+    };
+
+    //region stream_registry
+
+    static stream_registry _global_streams;
+
+    std::unordered_map<logger::severity, std::forward_list<std::shared_ptr<binary_stream>>> _output_streams;
+
+    binary_logger(const std::unordered_map<logger::severity, std::forward_list<std::string>>& paths);
+
+    friend binary_logger_builder;
+
+    void write_record(logger::severity severity, char const *format, std::string_view body);
+
+    template<typename T>
+    static void append_raw(std::string& out, T value)
+    {
+        out.append(reinterpret_cast<char const *>(&value), sizeof(value));
+    }
+
+    template<typename T>
+    static void append_argument(std::string& out, T const &value)
+    {
+        using arg_t = std::decay_t<T>;
+
+        if constexpr (std::is_same_v<arg_t, bool>)
+        {
+            append_raw(out, arg_type::BOOLEAN);
+            append_raw(out, static_cast<std::uint8_t>(value));
+        }
+        else if constexpr (std::is_same_v<arg_t, char>)
+        {
+            append_string(out, std::string_view(&value, 1));
+        }
+        else if constexpr (std::signed_integral<arg_t>)
+        {
+            append_raw(out, arg_type::SIGNED);
+            append_raw(out, static_cast<std::int64_t>(value));
+        }
+        else if constexpr (std::unsigned_integral<arg_t>)
+        {
+            append_raw(out, arg_type::UNSIGNED);
+            append_raw(out, static_cast<std::uint64_t>(value));
+        }
+        else if constexpr (std::floating_point<arg_t>)
+        {
+            append_raw(out, arg_type::FLOATING);
+            append_raw(out, static_cast<double>(value));
+        }
+        else
+        {
+            static_assert(std::is_convertible_v<T const &, std::string_view>, "unsupported binary log argument type");
+            append_string(out, std::string_view(value));
+        }
+    }
+
+    static void append_string(std::string& out, std::string_view value);
+
+    static void begin_record(std::string& out, logger::severity severity, std::size_t args_count);
+
+public:
+
+    binary_logger(binary_logger const &other) = default;
+
+    binary_logger &operator=(binary_logger const &other) = default;
+
+    binary_logger(binary_logger &&other) noexcept = default;
+
+    binary_logger &operator=(binary_logger &&other) noexcept = default;
+
+    ~binary_logger() noexcept final;
+
+public:
+
+    // Stored as the single argument of the "{}" format
+    [[nodiscard]] logger& log(
+        const std::string &message,
+        logger::severity severity) & override;
+
+    // Placeholders are "{}", "{{" and "}}" stand for braces; format must outlive the logger
+    template<typename... args_t>
+    binary_logger& log_format(
+        logger::severity severity,
+        char const *format,
+        args_t const &... args) &
+    {
+        if (!_output_streams.contains(severity))
+        {
+            return *this;
+        }
+
+        static_assert(sizeof...(args_t) <= UINT8_MAX, "too many binary log arguments");
+
+        thread_local std::string body;
+        begin_record(body, severity, sizeof...(args_t));
+        (append_argument(body, args), ...);
+
+        write_record(severity, format, body);
+        return *this;
+    }
+
+    logger& flush() & override;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOGGER_H
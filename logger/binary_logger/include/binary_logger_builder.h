@@ -0,0 +1,65 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOGGER_BUILDER_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOGGER_BUILDER_H
+
+#include <logger_builder.h>
+#include <unordered_map>
+#include <forward_list>
+#include <nlohmann/json.hpp>
+#include "binary_logger.h"
+
+// Loggers built for the same path, by one builder or several, write one shared stream of that file,
+// which is truncated when it is opened while no logger holds it
+class binary_logger_builder final:
+    public logger_builder
+{
+private:
+
+    std::unordered_map<logger::severity, std::forward_list<std::string>> _paths;
+
+    void parse_severity(logger::severity sev, nlohmann::json& j);
+
+public:
+
+    binary_logger_builder() = default;
+
+    binary_logger_builder(
+        binary_logger_builder const &other) =delete;
+
+    binary_logger_builder &operator=(
+        binary_logger_builder const &other) =delete;
+
+    binary_logger_builder(
+        binary_logger_builder &&other) noexcept =default;
+
+    binary_logger_builder &operator=(
+        binary_logger_builder &&other) noexcept =default;
+
+    ~binary_logger_builder() noexcept override =default;
+
+public:
+
+    logger_builder& add_file_stream(
+        std::string const &stream_file_path,
+        logger::severity severity) & override;
+
+    // binary records are not readable on a console
+    logger_builder& add_console_stream(
+        logger::severity severity) & override;
+
+    // only "paths" of each severity are used
+    logger_builder& transform_with_configuration(
+        std::string const &configuration_file_path,
+        std::string const &configuration_path) & override;
+
+    // text layout is chosen when decoding, so the format is ignored
+    logger_builder& set_format(const std::string& format) & override;
+
+    logger_builder& set_destination(const std::string& format) & override;
+
+    logger_builder& clear() & override;
+
+    [[nodiscard]] logger *build() const override;
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_LOGGER_BUILDER_H
@@ -0,0 +1,169 @@
+#include "../include/binary_log_decoder.h"
+#include "../include/binary_logger.h"
+#include <charconv>
+#include <ctime>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    template<typename T>
+    T read_raw(std::istream &in)
+    {
+        T value;
+        if (!in.read(reinterpret_cast<char *>(&value), sizeof(value))) {
+            throw std::runtime_error("Truncated binary log");
+        }
+        return value;
+    }
+
+    std::string read_bytes(std::istream &in, std::size_t length)
+    {
+        std::string value(length, '\0');
+        if (!in.read(value.data(), static_cast<std::streamsize>(length))) {
+            throw std::runtime_error("Truncated binary log");
+        }
+        return value;
+    }
+
+    std::string read_argument(std::istream &in)
+    {
+        using arg_type = binary_logger::arg_type;
+
+        switch (read_raw<arg_type>(in)) {
+            case arg_type::SIGNED:
+                return std::to_string(read_raw<std::int64_t>(in));
+            case arg_type::UNSIGNED:
+                return std::to_string(read_raw<std::uint64_t>(in));
+            case arg_type::FLOATING: {
+                // Shortest round trip representation, as std::format("{}") gives
+                char chars[32];
+                auto result = std::to_chars(chars, chars + sizeof(chars), read_raw<double>(in));
+                return {chars, result.ptr};
+            }
+            case arg_type::BOOLEAN:
+                return read_raw<std::uint8_t>(in) ? "true" : "false";
+            case arg_type::STRING:
+                return read_bytes(in, read_raw<std::uint32_t>(in));
+        }
+
+        throw std::runtime_error("Invalid binary log argument type");
+    }
+
+    std::string substitute(std::string const &format, std::vector<std::string> const &args)
+    {
+        std::string result;
+        std::size_t next_arg = 0;
+
+        for (std::size_t i = 0; i < format.size(); ++i) {
+            char c = format[i];
+            bool doubled = i + 1 < format.size() && format[i + 1] == c;
+
+            if ((c == '{' || c == '}') && doubled) {
+                result.push_back(c);
+                ++i;
+            } else if (c == '{' && i + 1 < format.size() && format[i + 1] == '}' && next_arg < args.size()) {
+                result.append(args[next_arg++]);
+                ++i;
+            } else {
+                result.push_back(c);
+            }
+        }
+
+        return result;
+    }
+
+    char const *severity_name(std::uint8_t severity)
+    {
+        static char const *const names[] = { "TRACE", "DEBUG", "INFORMATION", "WARNING", "ERROR", "CRITICAL" };
+
+        if (severity >= std::size(names)) {
+            throw std::runtime_error("Invalid binary log severity");
+        }
+        return names[severity];
+    }
+}
+
+void binary_log_decoder::decode(
+    std::istream &in,
+    std::ostream &out,
+    std::string const &format)
+{
+    auto header = read_bytes(in, binary_logger::magic.size());
+    if (header != binary_logger::magic) {
+        throw std::runtime_error("Not a binary log");
+    }
+
+    std::unordered_map<std::uint32_t, std::string> formats;
+    std::vector<std::string> args;
+
+    for (int tag = in.get(); tag != std::istream::traits_type::eof(); tag = in.get()) {
+        auto id = read_raw<std::uint32_t>(in);
+
+        if (tag == binary_logger::format_tag) {
+            formats[id] = read_bytes(in, read_raw<std::uint32_t>(in));
+            continue;
+        }
+        if (tag != binary_logger::record_tag) {
+            throw std::runtime_error("Invalid binary log record");
+        }
+
+        auto format_it = formats.find(id);
+        if (format_it == formats.end()) {
+            throw std::runtime_error("Binary log record references an undefined format");
+        }
+
+        auto nanoseconds = read_raw<std::int64_t>(in);
+        auto severity = read_raw<std::uint8_t>(in);
+        auto args_count = read_raw<std::uint8_t>(in);
+
+        args.clear();
+        for (std::uint8_t i = 0; i < args_count; ++i) {
+            args.push_back(read_argument(in));
+        }
+
+        std::time_t seconds = nanoseconds / 1'000'000'000;
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &seconds);
+#else
+        localtime_r(&seconds, &local);
+#endif
+
+        // Same flag rules as client_logger: unknown flags print the character itself
+        bool in_flag = false;
+        for (char c : format) {
+            if (c == '%') {
+                in_flag = true;
+                continue;
+            } else if (!in_flag) {
+                out.put(c);
+                continue;
+            }
+
+            char chars[16];
+            switch (c) {
+                case 'd':
+                    out.write(chars, static_cast<std::streamsize>(std::strftime(chars, sizeof(chars), "%d.%m.%Y", &local)));
+                    break;
+                case 't':
+                    out.write(chars, static_cast<std::streamsize>(std::strftime(chars, sizeof(chars), "%H:%M:%S", &local)));
+                    break;
+                case 's':
+                    out << severity_name(severity);
+                    break;
+                case 'm':
+                    out << substitute(format_it->second, args);
+                    break;
+                default:
+                    out.put(c);
+                    break;
+            }
+
+            in_flag = false;
+        }
+
+        out.put('\n');
+    }
+}
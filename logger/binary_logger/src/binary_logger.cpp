@@ -0,0 +1,137 @@
+#include "../include/binary_logger.h"
+#include <stdexcept>
+
+namespace
+{
+    constexpr std::size_t stream_buffer_size = 1 << 16;
+
+    char const *const message_format = "{}";
+}
+
+binary_logger::stream_registry binary_logger::_global_streams;
+
+binary_logger::binary_logger(
+    const std::unordered_map<logger::severity, std::forward_list<std::string>> &paths)
+{
+    // Severities and loggers sharing a path share its stream and format table
+    for (auto& [severity, severity_paths] : paths) {
+        auto& streams = _output_streams[severity];
+
+        for (auto& path : severity_paths) {
+            streams.push_front(_global_streams.open(path));
+        }
+    }
+}
+
+binary_logger::~binary_logger() noexcept
+{
+    try {
+        flush();
+    } catch (...) {
+    }
+}
+
+logger& binary_logger::log(
+    const std::string &message,
+    logger::severity severity) &
+{
+    return log_format(severity, message_format, message);
+}
+
+logger& binary_logger::flush() &
+{
+    for (auto& [severity, streams] : _output_streams) {
+        for (auto& stream : streams) {
+            stream->flush();
+        }
+    }
+
+    return *this;
+}
+
+void binary_logger::write_record(logger::severity severity, char const *format, std::string_view body)
+{
+    bool urgent = severity >= logger::severity::error;
+
+    for (auto& stream : _output_streams[severity]) {
+        stream->write(format, body, urgent);
+    }
+}
+
+void binary_logger::append_string(std::string &out, std::string_view value)
+{
+    append_raw(out, arg_type::STRING);
+    append_raw(out, static_cast<std::uint32_t>(value.size()));
+    out.append(value);
+}
+
+void binary_logger::begin_record(std::string &out, logger::severity severity, std::size_t args_count)
+{
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+
+    out.clear();
+    append_raw(out, static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()));
+    append_raw(out, static_cast<std::uint8_t>(severity));
+    append_raw(out, static_cast<std::uint8_t>(args_count));
+}
+
+std::shared_ptr<binary_logger::binary_stream> binary_logger::stream_registry::open(const std::string &path)
+{
+    std::lock_guard lock(_mutex);
+
+    if (auto stream = _streams[path].lock()) {
+        return stream;
+    }
+
+    // Files of loggers gone meanwhile are closed already
+    std::erase_if(_streams, [](auto const &entry) { return entry.second.expired(); });
+
+    auto stream = std::make_shared<binary_stream>(path);
+    _streams[path] = stream;
+    return stream;
+}
+
+binary_logger::binary_stream::binary_stream(const std::string &path) :
+    _buffer(std::make_unique<char[]>(stream_buffer_size))
+{
+    _stream.rdbuf()->pubsetbuf(_buffer.get(), stream_buffer_size);
+    _stream.open(path, std::ios::binary);
+
+    if (!_stream.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    _stream.write(magic.data(), static_cast<std::streamsize>(magic.size()));
+}
+
+void binary_logger::binary_stream::write(char const *format, std::string_view body, bool flush)
+{
+    std::lock_guard lock(_mutex);
+
+    auto [it, inserted] = _format_ids.try_emplace(format, static_cast<std::uint32_t>(_format_ids.size()));
+    std::uint32_t id = it->second;
+
+    if (inserted) {
+        std::string_view text(format);
+        auto length = static_cast<std::uint32_t>(text.size());
+
+        _stream.put(format_tag);
+        _stream.write(reinterpret_cast<char const *>(&id), sizeof(id));
+        _stream.write(reinterpret_cast<char const *>(&length), sizeof(length));
+        _stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    _stream.put(record_tag);
+    _stream.write(reinterpret_cast<char const *>(&id), sizeof(id));
+    _stream.write(body.data(), static_cast<std::streamsize>(body.size()));
+
+    if (flush) {
+        _stream.flush();
+    }
+}
+
+void binary_logger::binary_stream::flush()
+{
+    std::lock_guard lock(_mutex);
+    _stream.flush();
+}
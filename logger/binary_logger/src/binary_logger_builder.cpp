@@ -0,0 +1,77 @@
+#include <fstream>
+#include <not_implemented.h>
+#include <operation_not_supported.h>
+#include "../include/binary_logger_builder.h"
+
+logger_builder& binary_logger_builder::add_file_stream(
+    std::string const &stream_file_path,
+    logger::severity severity) &
+{
+    _paths[severity].push_front(stream_file_path);
+    return *this;
+}
+
+logger_builder& binary_logger_builder::add_console_stream(
+    logger::severity severity) &
+{
+    throw operation_not_supported();
+}
+
+logger_builder& binary_logger_builder::transform_with_configuration(
+    std::string const &configuration_file_path,
+    std::string const &configuration_path) &
+{
+    std::ifstream config_stream(configuration_file_path);
+
+    if (!config_stream.is_open()) {
+        throw std::runtime_error("Failed to open config file: "
+            + configuration_file_path);
+    }
+
+    // Read config file
+    nlohmann::json config_json;
+    config_stream >> config_json;
+
+    // Get config for current logger
+    auto& config = config_json[configuration_path];
+
+    for (auto& [key, value] : config.items()) {
+        if (key == "format") {
+            continue;
+        }
+        logger::severity severity = logger_builder::string_to_severity(key);
+        parse_severity(severity, value);
+    }
+
+    return *this;
+}
+
+void binary_logger_builder::parse_severity(logger::severity sev, nlohmann::json& j)
+{
+    if (j.contains("paths")) {
+        for (auto& path : j["paths"]) {
+            add_file_stream(path, sev);
+        }
+    }
+}
+
+logger_builder& binary_logger_builder::set_format(const std::string &format) &
+{
+    return *this;
+}
+
+logger_builder& binary_logger_builder::set_destination(const std::string &format) &
+{
+    throw not_implemented("logger_builder *binary_logger_builder::set_destination(const std::string &format)", "invalid call");
+}
+
+logger_builder& binary_logger_builder::clear() &
+{
+    _paths.clear();
+    return *this;
+}
+
+logger *binary_logger_builder::build() const
+{
+    return new binary_logger(_paths);
+}
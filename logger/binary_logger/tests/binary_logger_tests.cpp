@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "../include/binary_logger.h"
+#include "../include/binary_logger_builder.h"
+#include "../include/binary_log_decoder.h"
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+std::string decode_file(std::string const &path, std::string const &format)
+{
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream out;
+    binary_log_decoder::decode(in, out, format);
+    return out.str();
+}
+
+TEST(binary_logger, decodes_arguments)
+{
+    {
+        binary_logger_builder builder;
+        builder.add_file_stream("binary.log", logger::severity::trace)
+                .add_file_stream("binary.log", logger::severity::error);
+
+        std::unique_ptr<logger> log(builder.build());
+        auto &binary = dynamic_cast<binary_logger &>(*log);
+
+        binary.log_format(logger::severity::trace, "block {} of {} bytes at {}", 3, 128u, "head");
+        binary.log_format(logger::severity::error, "ratio {} is {}, {{literal}}", 0.5, true);
+        binary.log_format(logger::severity::debug, "not written {}", 1);
+        log->trace("plain message");
+        binary.log_format(logger::severity::trace, "block {} of {} bytes at {}", -1, 0u, std::string("tail"));
+    }
+
+    EXPECT_EQ(decode_file("binary.log", "[%s] %m"),
+              "[TRACE] block 3 of 128 bytes at head\n"
+              "[ERROR] ratio 0.5 is true, {literal}\n"
+              "[TRACE] plain message\n"
+              "[TRACE] block -1 of 0 bytes at tail\n");
+}
+
+TEST(binary_logger, shares_file_between_loggers)
+{
+    {
+        binary_logger_builder builder;
+        builder.add_file_stream("shared_binary.log", logger::severity::trace);
+
+        std::unique_ptr<logger> first(builder.build());
+        std::unique_ptr<logger> second(builder.build());
+
+        dynamic_cast<binary_logger &>(*first).log_format(logger::severity::trace, "first {}", 1);
+        dynamic_cast<binary_logger &>(*second).log_format(logger::severity::trace, "second {}", 2);
+        first->trace("plain from first");
+        first.reset();
+        second->trace("plain from second");
+    }
+
+    EXPECT_EQ(decode_file("shared_binary.log", "%m"),
+              "first 1\n"
+              "second 2\n"
+              "plain from first\n"
+              "plain from second\n");
+}
+
+TEST(binary_logger, rejects_foreign_file)
+{
+    {
+        std::ofstream out("not_binary.log");
+        out << "plain text";
+    }
+
+    EXPECT_THROW(decode_file("not_binary.log", "%m"), std::runtime_error);
+}
+
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,58 @@
+#include <log_segment.h>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+
+int main(int argc, char *argv[])
+{
+    bool list_index = argc == 3 && std::string(argv[1]) == "--index";
+
+    if (!list_index && argc != 2 && argc != 4)
+    {
+        std::cerr << "usage: " << argv[0] << " <segment> [from to, decompressed byte offsets]" << std::endl
+                  << "       " << argv[0] << " --index <segment>" << std::endl;
+        return 1;
+    }
+
+    char const *path = list_index ? argv[2] : argv[1];
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+    {
+        std::cerr << "Failed to open file: " << path << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        auto index = log_segment::read_index(in);
+
+        if (list_index)
+        {
+            for (auto const &block : index)
+            {
+                std::cout << block.file_offset << ' ' << block.raw_offset << ' ' << block.compressed_size << ' '
+                          << block.raw_size << '\n';
+            }
+            return 0;
+        }
+
+        std::uint64_t from = 0;
+        std::uint64_t to = std::numeric_limits<std::uint64_t>::max();
+        if (argc == 4)
+        {
+            from = std::stoull(argv[2]);
+            to = std::stoull(argv[3]);
+        }
+
+        log_segment::extract(in, index, from, to, std::cout);
+    }
+    catch (std::exception const &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -2,24 +2,269 @@
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_H
 
 #include <logger.h>
+#include "log_segment.h"
 #include <array>
 #include <unordered_map>
 #include <forward_list>
 #include <fstream>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <string_view>
+#include <mutex>
+#include <atomic>
 
 class client_logger_builder;
 
 class client_logger final:
     public logger
 {
+public:
+
+    // When buffered file records are pushed to disk
+    struct flush_policy
+    {
+        // flush once this many bytes are pending, 0 flushes every record
+        size_t bytes = 64 * 1024;
+
+        // flush on write if the last flush is older than this, 0 disables
+        std::chrono::milliseconds interval{1000};
+
+        // records of this severity and above are flushed immediately
+        logger::severity severity = logger::severity::error;
+    };
+
+    // When a file is moved to numbered segments path.1 (newest) .. path.keep
+    struct rotation_policy
+    {
+        // rotate before a record would grow the file past this size, also preallocated on open; 0 disables
+        size_t max_bytes = 0;
+
+        // rotate on write once the file is older than this, 0 disables
+        std::chrono::seconds interval{0};
+
+        // rotated segments kept, older ones are removed
+        size_t keep = 5;
+    };
+
+    // Layout of a record; json writes one object per line with date, time, severity, message and the
+    // record fields, ignoring the format string
+    enum class record_format
+    {
+        text,
+        json
+    };
+
 private:
+    // How a file is written, settled by the first logger opening it
+    struct sink_options
+    {
+        size_t buffer_size;
+
+        rotation_policy rotation;
+
+        // != 0 writes through mapped_file regions of that size, without buffering and rotation
+        size_t mapped_region;
+
+        // != 0 writes a log_segment with blocks of that size, without rotation; takes precedence over mapping
+        size_t compressed_block;
+    };
+
+    //region mapped_file
+
+    // Append-only file written through shared mappings of a fixed size. Writers reserve space with an
+    // atomic cursor and copy without locking; the one whose record crosses the end of a region maps the
+    // next region right after the last complete record
+    class mapped_file final
+    {
+        struct region
+        {
+            char* mapping = nullptr;
+
+            size_t mapping_size = 0;
+
+            // file offset `offset`, inside mapping past the page alignment
+            char* data = nullptr;
+
+            size_t offset = 0;
+
+            size_t size = 0;
+
+            std::atomic<size_t> cursor{0};
+
+            // threads that may be copying into data
+            std::atomic<size_t> writers{0};
+        };
+
+        int _fd = -1;
+
+        size_t _region_size = 0;
+
+        std::atomic<region*> _current{nullptr};
+
+        // set when mapping the next region failed, every later append throws
+        std::atomic<bool> _broken{false};
+
+        // retired regions are kept until close, a writer may still be checking one
+        std::vector<std::unique_ptr<region>> _regions;
+
+        std::unique_ptr<region> map_region(size_t offset, size_t size);
+
+        // current region with this thread registered as its writer
+        region* enter() noexcept;
+
+        void roll(region* full, size_t end, size_t record_size);
+
+    public:
+
+        mapped_file() = default;
+
+        mapped_file(const mapped_file&) = delete;
+
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        ~mapped_file() noexcept;
+
+        // truncates the file
+        void open(const std::string& path, size_t region_size);
+
+        void append(std::string_view record);
+
+        // schedules write back of the current region
+        void sync();
+
+        // cuts the file to the bytes actually written
+        void close();
+    };
+
+    //endregion mapped_file
+
+    //region compressed_file
+
+    // log_segment writer, records are gathered into blocks compressed one at a time; not thread safe
+    class compressed_file final
+    {
+        std::ofstream _stream;
+
+        size_t _block_size = 0;
+
+        std::string _block;
+
+        std::string _compressed;
+
+        std::uint64_t _file_size = 0;
+
+        std::uint64_t _raw_size = 0;
+
+        std::vector<log_segment::block_entry> _index;
+
+        void write_block();
+
+    public:
+
+        // truncates the file
+        void open(const std::string& path, size_t block_size);
+
+        void append(std::string_view record);
+
+        // writes out the pending records as a block of their own
+        void flush();
+
+        // appends the block index, after it the file can be read with log_segment
+        void close();
+    };
+
+    //endregion compressed_file
+
+    //region file_sink
+
+    // Single owner of an opened file, writers from all threads serialize on its mutex
+    class file_sink final
+    {
+        std::mutex _mutex;
+
+        // declared before the stream so it outlives it
+        std::unique_ptr<char[]> _buffer;
+
+        std::ofstream _stream;
+
+        size_t _unflushed = 0;
+
+        std::chrono::steady_clock::time_point _last_flush;
+
+        std::string _path;
+
+        rotation_policy _rotation;
+
+        size_t _written = 0;
+
+        std::chrono::steady_clock::time_point _opened;
+
+        // set by open, then writes bypass the stream and its mutex
+        std::unique_ptr<mapped_file> _mapped;
+
+        std::unique_ptr<compressed_file> _compressed;
+
+        void flush_unlocked();
+
+        void open_unlocked();
+
+        void rotate_unlocked();
+
+    public:
+
+        void open(const std::string& path, const sink_options& options);
+
+        [[nodiscard]] bool is_open();
+
+        //record is expected to end with a line break
+        void write(std::string_view record, logger::severity sev, const flush_policy& policy);
+
+        void flush();
+
+        void close();
+    };
+
+    //region file_sink
+
+    //region stream_registry
+
+    // Path -> refcounted file_sink, striped by path hash so unrelated files never share a lock
+    class stream_registry final
+    {
+        static constexpr size_t shards_count = 16;
+
+        struct shard
+        {
+            std::mutex mutex;
+
+            std::unordered_map<std::string, std::pair<size_t, file_sink>> streams;
+        };
+
+        std::array<shard, shards_count> _shards;
+
+        shard& shard_for(const std::string& path);
+
+    public:
+
+        void acquire(const std::string& path);
+
+        //opens the file on first call, pointer stays valid until the last release
+        file_sink* open(const std::string& path, const sink_options& options);
+
+        void release(const std::string& path);
+    };
+
+    //region stream_registry
+
     //region refcounted_stream
 
     class refcounted_stream final
     {
-        static std::unordered_map<std::string, std::pair<size_t, std::ofstream>> _global_streams;
+        static stream_registry _global_streams;
 
-        std::pair<std::string, std::ofstream*> _stream;
+        // empty path marks a moved-from stream
+        std::pair<std::string, file_sink*> _stream;
         friend client_logger;
         friend client_logger_builder;
     public:
@@ -34,8 +279,8 @@ private:
 
         refcounted_stream& operator=(refcounted_stream&& oth) noexcept;
 
-        //if ofstream* is nullptr initializes it with opened file from global map
-        void open();
+        //if file_sink* is nullptr initializes it with opened file from global map
+        void open(const sink_options& options);
 
         ~refcounted_stream();
     };
@@ -45,19 +290,45 @@ private:
     enum class flag
     { DATE, TIME, SEVERITY, MESSAGE, NO_FLAG };
 
+    // NO_FLAG token is a literal span [offset, offset + length) of _format
+    struct format_token
+    {
+        flag kind;
+        size_t offset;
+        size_t length;
+    };
+
 private:
 
     std::unordered_map<logger::severity ,std::pair<std::forward_list<refcounted_stream>, bool>> _output_streams;
 
     std::string _format;
 
+    std::vector<format_token> _format_tokens;
+
+    flush_policy _flush_policy;
+
+    rotation_policy _rotation_policy;
+
+    record_format _record_format;
+
+    sampling_policy _sampling;
+
+    size_t _mapped_region;
+
+    size_t _compressed_block;
 
 private:
 
     //opens all streams
-    client_logger(const std::unordered_map<logger::severity ,std::pair<std::forward_list<refcounted_stream>, bool>>& streams, std::string format);
+    client_logger(const std::unordered_map<logger::severity ,std::pair<std::forward_list<refcounted_stream>, bool>>& streams, std::string format, flush_policy policy, rotation_policy rotation, record_format layout, sampling_policy sampling, size_t mapped_region, size_t compressed_block);
+
+    static std::vector<format_token> compile_format(const std::string& format);
 
-    std::string make_format(const std::string& message, severity sev) const;
+    //writes formatted message, its fields and a line break into out, replacing its contents
+    void make_format(std::string& out, std::string_view message, std::span<field const> fields, severity sev) const;
+
+    void make_json(std::string& out, std::string_view message, std::span<field const> fields, severity sev) const;
 
     static flag char_to_flag(char c) noexcept;
 
@@ -76,10 +347,21 @@ public:
 
 public:
 
+    using logger::log;
+
     [[nodiscard]] logger& log(
         const std::string &message,
         logger::severity severity) & override;
 
+    logger& log(
+        logger::severity severity,
+        std::string_view message,
+        std::span<field const> fields) & override;
+
+    logger& flush() & override;
+
+    [[nodiscard]] sampling_policy const *sampling() const noexcept override;
+
 };
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_CLIENT_LOGGER_H
\ No newline at end of file
@@ -16,8 +16,26 @@ private:
 
     std::string _format;
 
+    client_logger::flush_policy _flush_policy;
+
+    client_logger::rotation_policy _rotation_policy;
+
+    client_logger::record_format _record_format = client_logger::record_format::text;
+
+    logger::sampling_policy _sampling;
+
+    size_t _mapped_region = 0;
+
+    size_t _compressed_block = 0;
+
     void parse_severity(logger::severity, nlohmann::json& j);
 
+    void parse_flush(nlohmann::json& j);
+
+    void parse_rotation(nlohmann::json& j);
+
+    void parse_sampling(nlohmann::json& j);
+
 public:
 
     client_logger_builder() : _format("%m"){};
@@ -55,6 +73,32 @@ public:
 
     logger_builder& clear() & override;
 
+    // 0 flushes after every record
+    client_logger_builder& set_flush_bytes(size_t bytes) &;
+
+    // 0 disables time based flushing
+    client_logger_builder& set_flush_interval(std::chrono::milliseconds interval) &;
+
+    client_logger_builder& set_flush_severity(logger::severity severity) &;
+
+    // 0 disables the respective trigger, keep is the number of old segments retained
+    client_logger_builder& set_rotation(size_t max_bytes, std::chrono::seconds interval, size_t keep) &;
+
+    client_logger_builder& set_record_format(client_logger::record_format layout) &;
+
+    // Applies to *_WITH_GUARD call sites logging through the built logger at max_severity and below;
+    // every == 1 and per_second == 0 turn sampling off
+    client_logger_builder& set_sampling(size_t every, size_t per_second,
+                                        logger::severity max_severity = logger::severity::debug) &;
+
+    // Files are written through shared memory mappings of region_bytes each instead of write calls,
+    // buffering and rotation do not apply to them; 0 turns it off
+    client_logger_builder& set_mapped_region(size_t region_bytes) &;
+
+    // Files are written as log_segment files of compressed blocks of block_bytes raw bytes each, read them
+    // back with mp_os_lggr_clnt_lggr_dcmprssr; rotation does not apply to them; 0 turns it off
+    client_logger_builder& set_compressed_blocks(size_t block_bytes) &;
+
     [[nodiscard]] logger *build() const override;
 
 };
@@ -0,0 +1,80 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOG_SEGMENT_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOG_SEGMENT_H
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Block compressed log file written by client_logger:
+//   "MPLOGZ1\0"
+//   blocks: u32 compressed size, u32 raw size, compressed bytes
+//   index:  u64 file offset, u64 raw offset, u32 compressed size, u32 raw size per block
+//   trailer: u64 index offset, u64 block count, "MPLOGZIX"
+// all integers little endian. A segment that was not closed has no index and is read by its block headers.
+class log_segment final
+{
+
+public:
+
+    static constexpr std::string_view magic{"MPLOGZ1\0", 8};
+
+    static constexpr std::string_view index_magic{"MPLOGZIX", 8};
+
+    static constexpr size_t block_header_size = 8;
+
+    static constexpr size_t index_entry_size = 24;
+
+    static constexpr size_t trailer_size = 24;
+
+    struct block_entry
+    {
+        // of the block header
+        std::uint64_t file_offset;
+
+        // of the first byte of the block in the decompressed log
+        std::uint64_t raw_offset;
+
+        std::uint32_t compressed_size;
+
+        std::uint32_t raw_size;
+    };
+
+public:
+
+    // LZ77 with a 64 KiB window, appends to out
+    static void compress(
+        std::string_view raw,
+        std::string &out);
+
+    // throws std::runtime_error if compressed does not decode to exactly raw_size bytes; appends to out
+    static void decompress(
+        std::string_view compressed,
+        size_t raw_size,
+        std::string &out);
+
+    static void append_u32(
+        std::string &out,
+        std::uint32_t value);
+
+    static void append_u64(
+        std::string &out,
+        std::uint64_t value);
+
+    // throws std::runtime_error on a malformed segment
+    static std::vector<block_entry> read_index(
+        std::istream &in);
+
+    // writes the decompressed bytes [from, to) of the log, to is clamped to its end
+    static void extract(
+        std::istream &in,
+        std::vector<block_entry> const &index,
+        std::uint64_t from,
+        std::uint64_t to,
+        std::ostream &out);
+
+};
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOG_SEGMENT_H
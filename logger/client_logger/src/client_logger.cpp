@@ -1,16 +1,32 @@
 #include <string>
-#include <sstream>
 #include <algorithm>
 #include <utility>
+#include <filesystem>
+#include <cstring>
+#include <thread>
 #include "../include/client_logger.h"
 #include <not_implemented.h>
 
-std::unordered_map<std::string, std::pair<size_t, std::ofstream>> client_logger::refcounted_stream::_global_streams;
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+client_logger::stream_registry client_logger::refcounted_stream::_global_streams;
 
 
 logger& client_logger::log(
     const std::string &text,
     logger::severity severity) &
+{
+    return log(severity, text, std::span<field const>());
+}
+
+logger& client_logger::log(
+    logger::severity severity,
+    std::string_view text,
+    std::span<field const> fields) &
 {
     auto streams_iter = _output_streams.find(severity);
 
@@ -18,76 +34,164 @@ logger& client_logger::log(
         return *this;
     }
 
-    std::string formatted_text = make_format(text, severity);
+    // Per thread so that one logger can be shared between threads
+    thread_local std::string buffer;
+
+    if (_record_format == record_format::json) {
+        make_json(buffer, text, fields, severity);
+    } else {
+        make_format(buffer, text, fields, severity);
+    }
 
     auto& streams = streams_iter->second;
 
     // If console stream is enabled, print to console
     if (streams.second) {
-        std::cout << formatted_text << std::endl;
+        std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
     }
 
-    // Print to all file streams
+    // Print to all file streams, flushing is up to the policy
     for (auto& file_stream : streams.first) {
         auto stream_ptr = file_stream._stream.second;
         if (stream_ptr != nullptr) {
-            *stream_ptr << formatted_text << std::endl;
+            stream_ptr->write(buffer, severity, _flush_policy);
         }
     }
 
     return *this;
 }
 
-std::string client_logger::make_format(const std::string &message, severity sev) const
+logger& client_logger::flush() &
 {
-    std::ostringstream msg;
+    std::cout.flush();
 
-    bool in_flag = false;
-
-    for (auto& c : _format) {
-        if (c == '%') {
-            in_flag = true;
-            continue;
-        } else if (!in_flag) {
-            msg << c;
-            continue;
+    for (auto& [severity, streams] : _output_streams) {
+        for (auto& file_stream : streams.first) {
+            if (file_stream._stream.second != nullptr) {
+                file_stream._stream.second->flush();
+            }
         }
+    }
+
+    return *this;
+}
+
+logger::sampling_policy const *client_logger::sampling() const noexcept
+{
+    bool sampled = _sampling.every > 1 || _sampling.per_second > 0;
+    return sampled ? &_sampling : nullptr;
+}
+
+void client_logger::make_format(std::string &out, std::string_view message, std::span<field const> fields,
+                                severity sev) const
+{
+    out.clear();
 
-        client_logger::flag flag = client_logger::char_to_flag(c);
+    // Only fetch the clock when the format actually uses it
+    logger::timestamp const *now = nullptr;
 
-        switch (flag) {
+    for (auto& token : _format_tokens) {
+        switch (token.kind) {
             case client_logger::flag::DATE:
-                msg << logger::current_date_to_string();
+                if (now == nullptr) {
+                    now = &logger::current_timestamp();
+                }
+                out.append(now->date());
                 break;
             case client_logger::flag::TIME:
-                msg << logger::current_time_to_string();
+                if (now == nullptr) {
+                    now = &logger::current_timestamp();
+                }
+                out.append(now->time());
                 break;
             case client_logger::flag::SEVERITY:
-                msg << logger::severity_to_string(sev);
+                out.append(logger::severity_to_string(sev));
                 break;
             case client_logger::flag::MESSAGE:
-                msg << message;
+                out.append(message);
+                append_fields_text(out, fields);
                 break;
             case client_logger::flag::NO_FLAG:
-                msg << c;
+                out.append(_format, token.offset, token.length);
                 break;
         }
+    }
+
+    out.push_back('\n');
+}
+
+void client_logger::make_json(std::string &out, std::string_view message, std::span<field const> fields,
+                              severity sev) const
+{
+    auto const &now = logger::current_timestamp();
+
+    out.assign("{\"date\":\"").append(now.date()).append("\",\"time\":\"").append(now.time())
+       .append("\",\"severity\":\"").append(logger::severity_to_string(sev)).append("\",\"message\":");
+    append_json_string(out, message);
+    append_fields_json(out, fields);
+    out.append("}\n");
+}
+
+std::vector<client_logger::format_token> client_logger::compile_format(const std::string &format)
+{
+    std::vector<format_token> tokens;
+
+    auto append_literal = [&tokens](size_t offset, size_t length) {
+        if (!tokens.empty() && tokens.back().kind == flag::NO_FLAG
+            && tokens.back().offset + tokens.back().length == offset) {
+            tokens.back().length += length;
+        } else {
+            tokens.push_back({flag::NO_FLAG, offset, length});
+        }
+    };
+
+    bool in_flag = false;
+
+    for (size_t i = 0; i < format.size(); ++i) {
+        char c = format[i];
+
+        if (c == '%') {
+            in_flag = true;
+            continue;
+        } else if (!in_flag) {
+            append_literal(i, 1);
+            continue;
+        }
+
+        client_logger::flag kind = client_logger::char_to_flag(c);
+
+        if (kind == flag::NO_FLAG) {
+            append_literal(i, 1);
+        } else {
+            tokens.push_back({kind, 0, 0});
+        }
 
         in_flag = false;
     }
 
-    return msg.str();
+    return tokens;
 }
 
 
 client_logger::client_logger(
         const std::unordered_map<logger::severity, std::pair<std::forward_list<refcounted_stream>, bool>> &streams,
-        std::string format) 
-    : _output_streams(streams), _format(format)
+        std::string format,
+        flush_policy policy,
+        rotation_policy rotation,
+        record_format layout,
+        sampling_policy sampling,
+        size_t mapped_region,
+        size_t compressed_block)
+    : _output_streams(streams), _format(std::move(format)), _format_tokens(compile_format(_format)),
+      _flush_policy(policy), _rotation_policy(rotation), _record_format(layout), _sampling(sampling),
+      _mapped_region(mapped_region), _compressed_block(compressed_block)
 {
+    sink_options options{_flush_policy.bytes, _rotation_policy, _mapped_region, _compressed_block};
+
+    // A file shared with other loggers keeps the options of the first one opening it
     for (auto& [severity, streams] : _output_streams) {
         for (auto& stream : streams.first) {
-            stream.open();
+            stream.open(options);
         }
     }
 }
@@ -107,12 +211,26 @@ client_logger::client_logger(const client_logger &other)
 {
     _output_streams = other._output_streams;
     _format = other._format;
+    _format_tokens = other._format_tokens;
+    _flush_policy = other._flush_policy;
+    _rotation_policy = other._rotation_policy;
+    _record_format = other._record_format;
+    _sampling = other._sampling;
+    _mapped_region = other._mapped_region;
+    _compressed_block = other._compressed_block;
 }
 
 client_logger &client_logger::operator=(const client_logger &other)
 {
     _output_streams = other._output_streams;
     _format = other._format;
+    _format_tokens = other._format_tokens;
+    _flush_policy = other._flush_policy;
+    _rotation_policy = other._rotation_policy;
+    _record_format = other._record_format;
+    _sampling = other._sampling;
+    _mapped_region = other._mapped_region;
+    _compressed_block = other._compressed_block;
     return *this;
 }
 
@@ -121,6 +239,13 @@ client_logger::client_logger(client_logger &&other) noexcept
     if (this != &other) {
         _output_streams = std::move(other._output_streams);
         _format = std::move(other._format);
+        _format_tokens = std::move(other._format_tokens);
+        _flush_policy = other._flush_policy;
+        _rotation_policy = other._rotation_policy;
+        _record_format = other._record_format;
+        _sampling = other._sampling;
+        _mapped_region = other._mapped_region;
+        _compressed_block = other._compressed_block;
     }
 }
 
@@ -129,38 +254,51 @@ client_logger &client_logger::operator=(client_logger &&other) noexcept
     if (this != &other) {
         _output_streams = std::move(other._output_streams);
         _format = std::move(other._format);
+        _format_tokens = std::move(other._format_tokens);
+        _flush_policy = other._flush_policy;
+        _rotation_policy = other._rotation_policy;
+        _record_format = other._record_format;
+        _sampling = other._sampling;
+        _mapped_region = other._mapped_region;
+        _compressed_block = other._compressed_block;
     }
     return *this;
 }
 
-client_logger::~client_logger() noexcept = default;
-
-client_logger::refcounted_stream::refcounted_stream(const std::string &path)
+client_logger::~client_logger() noexcept
 {
-    auto opened_stream = _global_streams.find(path);
-
-    if (opened_stream == _global_streams.end()) {
-        // Register empty stream
-        _global_streams[path] = {1, std::ofstream()};
-    } else {
-        // Increment refcount
-        opened_stream->second.first++;
+    try {
+        flush();
+    } catch (...) {
     }
+}
 
+client_logger::refcounted_stream::refcounted_stream(const std::string &path)
+{
+    _global_streams.acquire(path);
     _stream = {path, nullptr};
 }
 
 client_logger::refcounted_stream::refcounted_stream(const client_logger::refcounted_stream &oth)
 {
+    if (!oth._stream.first.empty()) {
+        _global_streams.acquire(oth._stream.first);
+    }
     _stream = oth._stream;
-    _global_streams[_stream.first].first++;
 }
 
 client_logger::refcounted_stream &
 client_logger::refcounted_stream::operator=(const client_logger::refcounted_stream &oth)
 {
-    _stream = oth._stream;
-    _global_streams[_stream.first].first++;
+    if (this != &oth) {
+        if (!oth._stream.first.empty()) {
+            _global_streams.acquire(oth._stream.first);
+        }
+        if (!_stream.first.empty()) {
+            _global_streams.release(_stream.first);
+        }
+        _stream = oth._stream;
+    }
 
     return *this;
 }
@@ -180,33 +318,474 @@ client_logger::refcounted_stream &client_logger::refcounted_stream::operator=(cl
     return *this;
 }
 
-void client_logger::refcounted_stream::open()
+void client_logger::refcounted_stream::open(const sink_options &options)
 {
     if (_stream.second != nullptr) {
         return;
     }
 
-    auto& stream = _global_streams[_stream.first].second;
+    _stream.second = _global_streams.open(_stream.first, options);
+}
 
-    if (stream.is_open()) {
-        _stream.second = &stream;
-        return;
+client_logger::refcounted_stream::~refcounted_stream()
+{
+    if (!_stream.first.empty()) {
+        _global_streams.release(_stream.first);
     }
+}
+
+client_logger::stream_registry::shard &client_logger::stream_registry::shard_for(const std::string &path)
+{
+    return _shards[std::hash<std::string>{}(path) % shards_count];
+}
+
+void client_logger::stream_registry::acquire(const std::string &path)
+{
+    auto& shard = shard_for(path);
+    std::lock_guard lock(shard.mutex);
+
+    // Registers empty stream on first use
+    shard.streams.try_emplace(path).first->second.first++;
+}
+
+client_logger::file_sink *client_logger::stream_registry::open(const std::string &path, const sink_options &options)
+{
+    auto& shard = shard_for(path);
+    std::lock_guard lock(shard.mutex);
 
-    stream.open(_stream.first);
+    auto& stream = shard.streams.try_emplace(path).first->second.second;
 
     if (!stream.is_open()) {
-        throw std::runtime_error("Failed to open file: " + _stream.first);
+        stream.open(path, options);
+
+        if (!stream.is_open()) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
     }
 
-    _stream.second = &stream;
+    return &stream;
 }
 
-client_logger::refcounted_stream::~refcounted_stream()
+void client_logger::stream_registry::release(const std::string &path)
+{
+    auto& shard = shard_for(path);
+    std::lock_guard lock(shard.mutex);
+
+    auto it = shard.streams.find(path);
+    if (it != shard.streams.end() && --it->second.first == 0) {
+        it->second.second.close();
+        shard.streams.erase(it);
+    }
+}
+
+void client_logger::file_sink::open(const std::string &path, const sink_options &options)
+{
+    std::lock_guard lock(_mutex);
+
+    _path = path;
+
+    if (options.compressed_block > 0) {
+        _compressed = std::make_unique<compressed_file>();
+        _compressed->open(path, options.compressed_block);
+        _last_flush = std::chrono::steady_clock::now();
+        return;
+    }
+
+    if (options.mapped_region > 0) {
+        _mapped = std::make_unique<mapped_file>();
+        _mapped->open(path, options.mapped_region);
+        return;
+    }
+
+    // Buffer has to be installed before the file is opened
+    if (options.buffer_size > 0) {
+        _buffer = std::make_unique<char[]>(options.buffer_size);
+        _stream.rdbuf()->pubsetbuf(_buffer.get(), static_cast<std::streamsize>(options.buffer_size));
+    }
+
+    _rotation = options.rotation;
+    open_unlocked();
+}
+
+void client_logger::file_sink::open_unlocked()
+{
+    _stream.open(_path);
+    _unflushed = 0;
+    _written = 0;
+    _last_flush = _opened = std::chrono::steady_clock::now();
+
+    if (!_stream.is_open() || _rotation.max_bytes == 0) {
+        return;
+    }
+
+#ifdef __linux__
+    // Reserve the whole segment up front without changing the file size, so appends do not allocate blocks
+    int fd = ::open(_path.c_str(), O_WRONLY);
+    if (fd != -1) {
+        ::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(_rotation.max_bytes));
+        ::close(fd);
+    }
+#endif
+}
+
+void client_logger::file_sink::rotate_unlocked()
 {
-    auto& stream = _global_streams[_stream.first];
-    if (--stream.first == 0) {
-        stream.second.close();
-        _global_streams.erase(_stream.first);
+    flush_unlocked();
+    _stream.close();
+
+    std::error_code ignored;
+    auto segment = [this](size_t number) { return _path + "." + std::to_string(number); };
+
+    if (_rotation.keep == 0) {
+        std::filesystem::remove(_path, ignored);
+    } else {
+        std::filesystem::remove(segment(_rotation.keep), ignored);
+        for (size_t number = _rotation.keep - 1; number > 0; --number) {
+            std::filesystem::rename(segment(number), segment(number + 1), ignored);
+        }
+        std::filesystem::rename(_path, segment(1), ignored);
+    }
+
+    open_unlocked();
+
+    if (!_stream.is_open()) {
+        throw std::runtime_error("Failed to reopen rotated file: " + _path);
+    }
+}
+
+bool client_logger::file_sink::is_open()
+{
+    std::lock_guard lock(_mutex);
+    return _mapped != nullptr || _compressed != nullptr || _stream.is_open();
+}
+
+void client_logger::file_sink::write(std::string_view record, logger::severity sev, const flush_policy &policy)
+{
+    if (_mapped) {
+        _mapped->append(record);
+        return;
+    }
+
+    std::lock_guard lock(_mutex);
+
+    if (_compressed) {
+        _compressed->append(record);
+
+        // Size is up to the block, severity and time still cut a block short
+        auto now = std::chrono::steady_clock::now();
+        if (sev >= policy.severity || (policy.interval.count() > 0 && now - _last_flush >= policy.interval)) {
+            _compressed->flush();
+            _last_flush = now;
+        }
+        return;
+    }
+
+    bool expired = false;
+    if (_rotation.interval.count() > 0) {
+        auto now = std::chrono::steady_clock::now();
+        expired = now - _opened >= _rotation.interval;
+
+        // An empty file is not worth a segment, its period just starts over
+        if (expired && _written == 0) {
+            _opened = now;
+        }
+    }
+
+    if (_written > 0 && (expired || (_rotation.max_bytes > 0 && _written + record.size() > _rotation.max_bytes))) {
+        rotate_unlocked();
+    }
+
+    _stream.write(record.data(), static_cast<std::streamsize>(record.size()));
+    _unflushed += record.size();
+    _written += record.size();
+
+    if (sev >= policy.severity || _unflushed >= policy.bytes) {
+        flush_unlocked();
+    } else if (policy.interval.count() > 0
+               && std::chrono::steady_clock::now() - _last_flush >= policy.interval) {
+        flush_unlocked();
+    }
+}
+
+void client_logger::file_sink::flush()
+{
+    if (_mapped) {
+        _mapped->sync();
+        return;
+    }
+
+    std::lock_guard lock(_mutex);
+
+    if (_compressed) {
+        _compressed->flush();
+        _last_flush = std::chrono::steady_clock::now();
+        return;
+    }
+
+    flush_unlocked();
+}
+
+void client_logger::file_sink::flush_unlocked()
+{
+    if (_unflushed == 0) {
+        return;
+    }
+
+    _stream.flush();
+    _unflushed = 0;
+    _last_flush = std::chrono::steady_clock::now();
+}
+
+void client_logger::file_sink::close()
+{
+    std::lock_guard lock(_mutex);
+
+    if (_mapped) {
+        _mapped->close();
+        _mapped.reset();
+        return;
+    }
+
+    if (_compressed) {
+        _compressed->close();
+        _compressed.reset();
+        return;
+    }
+
+    flush_unlocked();
+    _stream.close();
+}
+
+void client_logger::compressed_file::open(const std::string &path, size_t block_size)
+{
+    _stream.open(path, std::ios::binary | std::ios::trunc);
+    if (!_stream.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    _block_size = block_size;
+    _block.reserve(block_size);
+    _stream.write(log_segment::magic.data(), static_cast<std::streamsize>(log_segment::magic.size()));
+    _file_size = log_segment::magic.size();
+}
+
+void client_logger::compressed_file::append(std::string_view record)
+{
+    _block.append(record);
+
+    if (_block.size() >= _block_size) {
+        write_block();
+    }
+}
+
+void client_logger::compressed_file::write_block()
+{
+    if (_block.empty()) {
+        return;
+    }
+
+    _compressed.clear();
+    log_segment::append_u32(_compressed, 0);
+    log_segment::append_u32(_compressed, static_cast<std::uint32_t>(_block.size()));
+    log_segment::compress(_block, _compressed);
+
+    auto compressed_size = static_cast<std::uint32_t>(_compressed.size() - log_segment::block_header_size);
+    std::string size_field;
+    log_segment::append_u32(size_field, compressed_size);
+    std::copy(size_field.begin(), size_field.end(), _compressed.begin());
+
+    _stream.write(_compressed.data(), static_cast<std::streamsize>(_compressed.size()));
+    _index.push_back({_file_size, _raw_size, compressed_size, static_cast<std::uint32_t>(_block.size())});
+
+    _file_size += _compressed.size();
+    _raw_size += _block.size();
+    _block.clear();
+}
+
+void client_logger::compressed_file::flush()
+{
+    write_block();
+    _stream.flush();
+}
+
+void client_logger::compressed_file::close()
+{
+    if (!_stream.is_open()) {
+        return;
+    }
+
+    write_block();
+
+    std::string index;
+    index.reserve(_index.size() * log_segment::index_entry_size + log_segment::trailer_size);
+    for (auto &entry : _index) {
+        log_segment::append_u64(index, entry.file_offset);
+        log_segment::append_u64(index, entry.raw_offset);
+        log_segment::append_u32(index, entry.compressed_size);
+        log_segment::append_u32(index, entry.raw_size);
+    }
+
+    log_segment::append_u64(index, _file_size);
+    log_segment::append_u64(index, _index.size());
+    index.append(log_segment::index_magic);
+
+    _stream.write(index.data(), static_cast<std::streamsize>(index.size()));
+    _stream.close();
+}
+
+client_logger::mapped_file::~mapped_file() noexcept
+{
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void client_logger::mapped_file::open(const std::string &path, size_t region_size)
+{
+#ifdef _WIN32
+    throw not_implemented("void client_logger::mapped_file::open(const std::string &, size_t)",
+                          "memory mapped log files are not supported on Windows");
+#else
+    _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (_fd == -1) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+
+    _region_size = region_size;
+    _regions.push_back(map_region(0, _region_size));
+    _current.store(_regions.back().get());
+#endif
+}
+
+std::unique_ptr<client_logger::mapped_file::region> client_logger::mapped_file::map_region(size_t offset, size_t size)
+{
+    auto result = std::make_unique<region>();
+
+#ifndef _WIN32
+    // Allocated up front, a full disk shows up here instead of as SIGBUS on a store into the mapping
+    if (::posix_fallocate(_fd, static_cast<off_t>(offset), static_cast<off_t>(size)) != 0) {
+        throw std::runtime_error("Failed to reserve mapped log region");
+    }
+
+    static size_t const page_size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    size_t aligned = offset / page_size * page_size;
+
+    result->mapping_size = offset - aligned + size;
+    void *mapping = ::mmap(nullptr, result->mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd,
+                           static_cast<off_t>(aligned));
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map log region");
+    }
+
+    result->mapping = static_cast<char *>(mapping);
+    result->data = result->mapping + (offset - aligned);
+    result->offset = offset;
+    result->size = size;
+#endif
+
+    return result;
+}
+
+client_logger::mapped_file::region *client_logger::mapped_file::enter() noexcept
+{
+    while (true) {
+        region *current = _current.load();
+        current->writers.fetch_add(1);
+
+        // Pairs with roll: either it sees this writer or this writer sees the new region
+        if (_current.load() == current) {
+            return current;
+        }
+
+        current->writers.fetch_sub(1);
+    }
+}
+
+void client_logger::mapped_file::append(std::string_view record)
+{
+    while (true) {
+        region *current = enter();
+        size_t at = current->cursor.fetch_add(record.size());
+
+        if (at + record.size() <= current->size) {
+            std::memcpy(current->data + at, record.data(), record.size());
+            current->writers.fetch_sub(1);
+            return;
+        }
+
+        current->writers.fetch_sub(1);
+
+        if (at <= current->size) {
+            // Exactly one record crosses the end, the region holds everything before it
+            try {
+                roll(current, at, record.size());
+            } catch (...) {
+                _broken.store(true);
+                throw;
+            }
+        } else {
+            while (_current.load() == current && !_broken.load()) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (_broken.load()) {
+            throw std::runtime_error("Mapped log file could not grow");
+        }
+    }
+}
+
+void client_logger::mapped_file::roll(region *full, size_t end, size_t record_size)
+{
+#ifndef _WIN32
+    _regions.push_back(map_region(full->offset + end, std::max(_region_size, record_size)));
+    _current.store(_regions.back().get());
+
+    while (full->writers.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    ::munmap(full->mapping, full->mapping_size);
+    full->mapping = full->data = nullptr;
+#endif
+}
+
+void client_logger::mapped_file::sync()
+{
+#ifndef _WIN32
+    region *current = enter();
+    ::msync(current->mapping, current->mapping_size, MS_ASYNC);
+    current->writers.fetch_sub(1);
+#endif
+}
+
+void client_logger::mapped_file::close()
+{
+#ifndef _WIN32
+    if (_fd == -1) {
+        return;
+    }
+
+    // No writers are left at this point
+    region *current = _current.load();
+    size_t length = current->offset + std::min(current->cursor.load(), current->size);
+
+    for (auto &retired : _regions) {
+        if (retired->mapping != nullptr) {
+            ::munmap(retired->mapping, retired->mapping_size);
+            retired->mapping = retired->data = nullptr;
+        }
+    }
+    _regions.clear();
+    _current.store(nullptr);
+
+    int truncated = ::ftruncate(_fd, static_cast<off_t>(length));
+    ::close(_fd);
+    _fd = -1;
+
+    if (truncated != 0) {
+        throw std::runtime_error("Failed to truncate mapped log file");
     }
+#endif
 }
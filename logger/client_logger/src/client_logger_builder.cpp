@@ -44,8 +44,36 @@ logger_builder& client_logger_builder::transform_with_configuration(
         set_format(config["format"]);
     }
 
+    if (config.contains("flush")) {
+        parse_flush(config["flush"]);
+    }
+
+    if (config.contains("rotation")) {
+        parse_rotation(config["rotation"]);
+    }
+
+    if (config.contains("mapped_region_bytes")) {
+        set_mapped_region(config["mapped_region_bytes"].get<size_t>());
+    }
+
+    if (config.contains("compressed_block_bytes")) {
+        set_compressed_blocks(config["compressed_block_bytes"].get<size_t>());
+    }
+
+    if (config.contains("sampling")) {
+        parse_sampling(config["sampling"]);
+    }
+
+    // "record": "text" or "json"
+    if (config.contains("record")) {
+        set_record_format(config["record"] == "json" ? client_logger::record_format::json
+                                                     : client_logger::record_format::text);
+    }
+
     for (auto& [key, value] : config.items()) {
-        if (key == "format") {
+        if (key == "format" || key == "flush" || key == "rotation" || key == "record"
+            || key == "sampling" || key == "mapped_region_bytes"
+            || key == "compressed_block_bytes") {
             continue;
         }
         logger::severity severity = logger_builder::string_to_severity(key);
@@ -58,12 +86,43 @@ logger_builder& client_logger_builder::transform_with_configuration(
 logger_builder& client_logger_builder::clear() &
 {
     _output_streams.clear();
+    _flush_policy = client_logger::flush_policy();
+    _rotation_policy = client_logger::rotation_policy();
+    _record_format = client_logger::record_format::text;
+    _sampling = logger::sampling_policy();
+    _mapped_region = 0;
+    _compressed_block = 0;
     return *this;
 }
 
 logger *client_logger_builder::build() const
 {
-    return new client_logger(_output_streams, _format);
+    return new client_logger(_output_streams, _format, _flush_policy, _rotation_policy, _record_format, _sampling,
+                             _mapped_region, _compressed_block);
+}
+
+client_logger_builder& client_logger_builder::set_flush_bytes(size_t bytes) &
+{
+    _flush_policy.bytes = bytes;
+    return *this;
+}
+
+client_logger_builder& client_logger_builder::set_flush_interval(std::chrono::milliseconds interval) &
+{
+    _flush_policy.interval = interval;
+    return *this;
+}
+
+client_logger_builder& client_logger_builder::set_flush_severity(logger::severity severity) &
+{
+    _flush_policy.severity = severity;
+    return *this;
+}
+
+client_logger_builder& client_logger_builder::set_record_format(client_logger::record_format layout) &
+{
+    _record_format = layout;
+    return *this;
 }
 
 logger_builder& client_logger_builder::set_format(const std::string &format) &
@@ -84,6 +143,63 @@ void client_logger_builder::parse_severity(logger::severity sev, nlohmann::json&
     }
 }
 
+client_logger_builder& client_logger_builder::set_rotation(size_t max_bytes, std::chrono::seconds interval, size_t keep) &
+{
+    _rotation_policy.max_bytes = max_bytes;
+    _rotation_policy.interval = interval;
+    _rotation_policy.keep = keep;
+    return *this;
+}
+
+void client_logger_builder::parse_rotation(nlohmann::json& j)
+{
+    set_rotation(j.value("max_bytes", size_t(0)),
+                 std::chrono::seconds(j.value("interval_s", 0LL)),
+                 j.value("keep", _rotation_policy.keep));
+}
+
+client_logger_builder& client_logger_builder::set_sampling(size_t every, size_t per_second,
+                                                           logger::severity max_severity) &
+{
+    _sampling.every = every;
+    _sampling.per_second = per_second;
+    _sampling.max_severity = max_severity;
+    return *this;
+}
+
+client_logger_builder& client_logger_builder::set_mapped_region(size_t region_bytes) &
+{
+    _mapped_region = region_bytes;
+    return *this;
+}
+
+client_logger_builder& client_logger_builder::set_compressed_blocks(size_t block_bytes) &
+{
+    _compressed_block = block_bytes;
+    return *this;
+}
+
+void client_logger_builder::parse_sampling(nlohmann::json& j)
+{
+    set_sampling(j.value("every", size_t(1)),
+                 j.value("per_second", size_t(0)),
+                 j.contains("max_severity") ? logger_builder::string_to_severity(j["max_severity"])
+                                            : logger::severity::debug);
+}
+
+void client_logger_builder::parse_flush(nlohmann::json& j)
+{
+    if (j.contains("bytes")) {
+        set_flush_bytes(j["bytes"].get<size_t>());
+    }
+    if (j.contains("interval_ms")) {
+        set_flush_interval(std::chrono::milliseconds(j["interval_ms"].get<long long>()));
+    }
+    if (j.contains("severity")) {
+        set_flush_severity(logger_builder::string_to_severity(j["severity"]));
+    }
+}
+
 logger_builder& client_logger_builder::set_destination(const std::string &format) &
 {
     throw not_implemented("logger_builder *client_logger_builder::set_destination(const std::string &format)", "invalid call");
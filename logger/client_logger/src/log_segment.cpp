@@ -0,0 +1,332 @@
+#include "../include/log_segment.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    constexpr size_t min_match = 4;
+
+    constexpr size_t hash_bits = 12;
+
+    constexpr size_t max_distance = 0xffff;
+
+    // Low nibble of a token is the match length, high nibble the literal length; 15 continues in
+    // following bytes of 255 closed by one below it
+    constexpr unsigned length_escape = 15;
+
+    std::uint32_t read_u32(char const *at) noexcept
+    {
+        std::uint32_t value;
+        std::memcpy(&value, at, sizeof(value));
+        return value;
+    }
+
+    void append_length(std::string &out, size_t length)
+    {
+        for (; length >= 255; length -= 255)
+        {
+            out.push_back(static_cast<char>(255));
+        }
+        out.push_back(static_cast<char>(length));
+    }
+
+    void append_sequence(std::string &out, std::string_view literals, size_t distance, size_t match)
+    {
+        size_t match_code = match == 0 ? 0 : match - min_match;
+        auto token = static_cast<unsigned char>((std::min<size_t>(literals.size(), length_escape) << 4)
+                                                | std::min<size_t>(match_code, length_escape));
+        out.push_back(static_cast<char>(token));
+
+        if (literals.size() >= length_escape)
+        {
+            append_length(out, literals.size() - length_escape);
+        }
+        out.append(literals);
+
+        if (match == 0)
+        {
+            return;
+        }
+
+        out.push_back(static_cast<char>(distance & 0xff));
+        out.push_back(static_cast<char>(distance >> 8));
+
+        if (match_code >= length_escape)
+        {
+            append_length(out, match_code - length_escape);
+        }
+    }
+
+    std::uint64_t decode_little_endian(char const *at, size_t size) noexcept
+    {
+        std::uint64_t value = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            value |= static_cast<std::uint64_t>(static_cast<unsigned char>(at[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    std::uint64_t decode_u64(char const *at) noexcept
+    {
+        return decode_little_endian(at, 8);
+    }
+
+    std::uint32_t decode_u32(char const *at) noexcept
+    {
+        return static_cast<std::uint32_t>(decode_little_endian(at, 4));
+    }
+}
+
+void log_segment::compress(
+    std::string_view raw,
+    std::string &out)
+{
+    // Last position of every hashed 4 byte sequence, offset by one so that 0 means none
+    std::array<std::uint32_t, 1 << hash_bits> positions{};
+
+    size_t anchor = 0;
+    size_t i = 0;
+
+    while (i + min_match <= raw.size())
+    {
+        std::uint32_t sequence = read_u32(raw.data() + i);
+        size_t hash = (sequence * 2654435761u) >> (32 - hash_bits);
+        size_t candidate = positions[hash];
+        positions[hash] = static_cast<std::uint32_t>(i + 1);
+
+        if (candidate == 0 || i - (candidate - 1) > max_distance || read_u32(raw.data() + candidate - 1) != sequence)
+        {
+            ++i;
+            continue;
+        }
+
+        --candidate;
+        size_t length = min_match;
+        while (i + length < raw.size() && raw[candidate + length] == raw[i + length])
+        {
+            ++length;
+        }
+
+        append_sequence(out, raw.substr(anchor, i - anchor), i - candidate, length);
+        i += length;
+        anchor = i;
+    }
+
+    // Always closed by a sequence without a match, which is how the decoder finds the end
+    append_sequence(out, raw.substr(anchor), 0, 0);
+}
+
+void log_segment::decompress(
+    std::string_view compressed,
+    size_t raw_size,
+    std::string &out)
+{
+    size_t const start = out.size();
+    size_t pos = 0;
+
+    auto fail = []
+    {
+        throw std::runtime_error("Corrupt compressed log block");
+    };
+
+    auto read_length = [&](size_t length)
+    {
+        if (length != length_escape)
+        {
+            return length;
+        }
+
+        unsigned char next;
+        do
+        {
+            if (pos >= compressed.size())
+            {
+                fail();
+            }
+            next = static_cast<unsigned char>(compressed[pos++]);
+            length += next;
+        }
+        while (next == 255);
+
+        return length;
+    };
+
+    while (true)
+    {
+        if (pos >= compressed.size())
+        {
+            fail();
+        }
+
+        auto token = static_cast<unsigned char>(compressed[pos++]);
+
+        size_t literals = read_length(token >> 4);
+        if (literals > compressed.size() - pos || out.size() - start + literals > raw_size)
+        {
+            fail();
+        }
+        out.append(compressed.substr(pos, literals));
+        pos += literals;
+
+        if (pos == compressed.size())
+        {
+            break;
+        }
+
+        if (compressed.size() - pos < 2)
+        {
+            fail();
+        }
+        size_t distance = static_cast<unsigned char>(compressed[pos])
+                          | static_cast<size_t>(static_cast<unsigned char>(compressed[pos + 1])) << 8;
+        pos += 2;
+
+        size_t match = read_length(token & 0x0f) + min_match;
+        if (distance == 0 || distance > out.size() - start || out.size() - start + match > raw_size)
+        {
+            fail();
+        }
+
+        // Byte by byte, a match may overlap the bytes it produces
+        size_t from = out.size() - distance;
+        for (size_t i = 0; i < match; ++i)
+        {
+            out.push_back(out[from + i]);
+        }
+    }
+
+    if (out.size() - start != raw_size)
+    {
+        fail();
+    }
+}
+
+void log_segment::append_u32(
+    std::string &out,
+    std::uint32_t value)
+{
+    for (size_t i = 0; i < 4; ++i)
+    {
+        out.push_back(static_cast<char>(value >> (8 * i) & 0xff));
+    }
+}
+
+void log_segment::append_u64(
+    std::string &out,
+    std::uint64_t value)
+{
+    for (size_t i = 0; i < 8; ++i)
+    {
+        out.push_back(static_cast<char>(value >> (8 * i) & 0xff));
+    }
+}
+
+std::vector<log_segment::block_entry> log_segment::read_index(
+    std::istream &in)
+{
+    char header[magic.size()];
+    in.seekg(0);
+    if (!in.read(header, sizeof(header)) || std::string_view(header, sizeof(header)) != magic)
+    {
+        throw std::runtime_error("Not a compressed log segment");
+    }
+
+    in.seekg(0, std::ios::end);
+    auto file_size = static_cast<std::uint64_t>(in.tellg());
+
+    std::vector<block_entry> index;
+
+    char trailer[trailer_size];
+    if (file_size >= magic.size() + trailer_size)
+    {
+        in.seekg(static_cast<std::streamoff>(file_size - trailer_size));
+        in.read(trailer, sizeof(trailer));
+
+        if (in && std::string_view(trailer + 16, index_magic.size()) == index_magic)
+        {
+            std::uint64_t index_offset = decode_u64(trailer);
+            std::uint64_t count = decode_u64(trailer + 8);
+
+            if (index_offset + count * index_entry_size + trailer_size != file_size)
+            {
+                throw std::runtime_error("Corrupt compressed log index");
+            }
+
+            std::string entries(count * index_entry_size, '\0');
+            in.seekg(static_cast<std::streamoff>(index_offset));
+            in.read(entries.data(), static_cast<std::streamsize>(entries.size()));
+
+            index.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                char const *entry = entries.data() + i * index_entry_size;
+                index.push_back({decode_u64(entry), decode_u64(entry + 8), decode_u32(entry + 16),
+                                 decode_u32(entry + 20)});
+            }
+
+            return index;
+        }
+    }
+
+    // No index, walk the block headers up to the first incomplete block
+    in.clear();
+    std::uint64_t offset = magic.size();
+    std::uint64_t raw_offset = 0;
+    char block_header[block_header_size];
+
+    while (offset + block_header_size <= file_size)
+    {
+        in.seekg(static_cast<std::streamoff>(offset));
+        in.read(block_header, sizeof(block_header));
+
+        block_entry entry{offset, raw_offset, decode_u32(block_header), decode_u32(block_header + 4)};
+        if (offset + block_header_size + entry.compressed_size > file_size)
+        {
+            break;
+        }
+
+        index.push_back(entry);
+        offset += block_header_size + entry.compressed_size;
+        raw_offset += entry.raw_size;
+    }
+
+    return index;
+}
+
+void log_segment::extract(
+    std::istream &in,
+    std::vector<block_entry> const &index,
+    std::uint64_t from,
+    std::uint64_t to,
+    std::ostream &out)
+{
+    // First block ending after from
+    auto block = std::upper_bound(index.begin(), index.end(), from, [](std::uint64_t offset, block_entry const &entry)
+    {
+        return offset < entry.raw_offset + entry.raw_size;
+    });
+
+    std::string compressed;
+    std::string raw;
+
+    for (; block != index.end() && block->raw_offset < to; ++block)
+    {
+        compressed.resize(block->compressed_size);
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(block->file_offset + block_header_size));
+        if (!in.read(compressed.data(), static_cast<std::streamsize>(compressed.size())))
+        {
+            throw std::runtime_error("Truncated compressed log block");
+        }
+
+        raw.clear();
+        decompress(compressed, block->raw_size, raw);
+
+        std::uint64_t begin = std::max(from, block->raw_offset) - block->raw_offset;
+        std::uint64_t end = std::min<std::uint64_t>(to - block->raw_offset, block->raw_size);
+        out.write(raw.data() + begin, static_cast<std::streamsize>(end - begin));
+    }
+}
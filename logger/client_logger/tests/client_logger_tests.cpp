@@ -1,8 +1,259 @@
 #include <gtest/gtest.h>
 #include "../include/client_logger.h"
 #include "../include/client_logger_builder.h"
+#include <logger_guardant.h>
 
 #include <filesystem>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+TEST(client_logger_flush, error_reaches_file_immediately)
+{
+    client_logger_builder builder;
+    builder.set_flush_bytes(1 << 20).set_flush_interval(std::chrono::milliseconds(0));
+    builder.add_file_stream("flush.txt", logger::severity::trace)
+            .add_file_stream("flush.txt", logger::severity::error);
+
+    std::unique_ptr<logger> log(builder.build());
+
+    log->trace("buffered");
+    EXPECT_EQ(std::filesystem::file_size("flush.txt"), 0);
+
+    log->error("flushed");
+    EXPECT_EQ(std::filesystem::file_size("flush.txt"), std::string("buffered\nflushed\n").size());
+}
+
+TEST(client_logger_rotation, keeps_numbered_segments)
+{
+    for (auto name : {"rotated.txt", "rotated.txt.1", "rotated.txt.2", "rotated.txt.3"}) {
+        std::filesystem::remove(name);
+    }
+
+    {
+        client_logger_builder builder;
+        builder.set_rotation(6, std::chrono::seconds(0), 2);
+        builder.add_file_stream("rotated.txt", logger::severity::information);
+
+        std::unique_ptr<logger> log(builder.build());
+        log->information("one").information("two").information("three").information("four");
+    }
+
+    auto read = [](const char *name) {
+        std::ifstream in(name);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    };
+
+    EXPECT_EQ(read("rotated.txt"), "four\n");
+    EXPECT_EQ(read("rotated.txt.1"), "three\n");
+    EXPECT_EQ(read("rotated.txt.2"), "two\n");
+    EXPECT_FALSE(std::filesystem::exists("rotated.txt.3"));
+}
+
+TEST(client_logger_compression, extracts_ranges_through_index)
+{
+    std::string expected;
+
+    {
+        client_logger_builder builder;
+        builder.set_compressed_blocks(1024);
+        builder.add_file_stream("compressed.log", logger::severity::trace);
+
+        std::unique_ptr<logger> log(builder.build());
+        for (size_t i = 0; i < 200; ++i) {
+            std::string message = "request " + std::to_string(i % 7) + " served in " + std::to_string(i) + " ms";
+            log->trace(message);
+            expected += message + "\n";
+        }
+    }
+
+    EXPECT_LT(std::filesystem::file_size("compressed.log"), expected.size() / 2);
+
+    std::ifstream in("compressed.log", std::ios::binary);
+    auto index = log_segment::read_index(in);
+    ASSERT_GT(index.size(), 1);
+
+    std::ostringstream all;
+    log_segment::extract(in, index, 0, expected.size() + 100, all);
+    EXPECT_EQ(all.str(), expected);
+
+    std::ostringstream part;
+    log_segment::extract(in, index, 1000, 3000, part);
+    EXPECT_EQ(part.str(), expected.substr(1000, 2000));
+}
+
+TEST(client_logger_fields, renders_text_and_json)
+{
+    std::string key_text = "text";
+
+    {
+        client_logger_builder builder;
+        builder.set_format("%s %m").add_file_stream("fields.txt", logger::severity::information);
+
+        std::unique_ptr<logger> log(builder.build());
+        log->log(logger::severity::information, "allocated", {{"bytes", 64u}, {"ok", true}, {key_text, "a b"}});
+        log->information("plain");
+    }
+
+    {
+        client_logger_builder builder;
+        builder.set_record_format(client_logger::record_format::json)
+                .add_file_stream("fields.json", logger::severity::warning);
+
+        std::unique_ptr<logger> log(builder.build());
+        log->log(logger::severity::warning, "say \"hi\"", {{"delta", -3}, {"ratio", 0.5}});
+    }
+
+    std::ifstream text("fields.txt");
+    std::string line;
+
+    std::getline(text, line);
+    EXPECT_EQ(line, "INFORMATION allocated bytes=64 ok=true text=a b");
+    std::getline(text, line);
+    EXPECT_EQ(line, "INFORMATION plain");
+
+    std::ifstream json("fields.json");
+    std::getline(json, line);
+    EXPECT_EQ(line.substr(line.find("\"severity\"")),
+              "\"severity\":\"WARNING\",\"message\":\"say \\\"hi\\\"\",\"delta\":-3,\"ratio\":0.5}");
+}
+
+namespace
+{
+    class sampled_site final : public logger_guardant
+    {
+        logger *_logger;
+
+    public:
+
+        explicit sampled_site(logger *got_logger) : _logger(got_logger) {}
+
+        void run(int times) const
+        {
+            for (int i = 0; i < times; ++i) {
+                TRACE_WITH_GUARD("tick " + std::to_string(i));
+            }
+            ERROR_WITH_GUARD("never sampled");
+        }
+
+    private:
+
+        logger *get_logger() const override
+        {
+            return _logger;
+        }
+    };
+}
+
+TEST(client_logger_sampling, keeps_one_in_n_and_reports_suppressed)
+{
+    {
+        client_logger_builder builder;
+        builder.set_sampling(10, 0).add_file_stream("sampled.txt", logger::severity::trace)
+                .add_file_stream("sampled.txt", logger::severity::error);
+
+        std::unique_ptr<logger> log(builder.build());
+        sampled_site(log.get()).run(100);
+    }
+
+    std::ifstream in("sampled.txt");
+    std::string line;
+    size_t kept = 0;
+    size_t summaries = 0;
+    std::string last;
+
+    while (std::getline(in, line)) {
+        last = line;
+        if (line.starts_with("tick ")) {
+            ++kept;
+        } else if (line.starts_with("[sampling] suppressed records count=9 ")) {
+            ++summaries;
+        }
+    }
+
+    EXPECT_EQ(kept, 10);
+    EXPECT_EQ(summaries, 9);
+    EXPECT_EQ(last, "never sampled");
+}
+
+TEST(client_logger_threads, loggers_share_file_between_threads)
+{
+    constexpr size_t threads_count = 8, messages_count = 1000;
+
+    std::filesystem::remove("shared.txt");
+
+    {
+        // Keeps the file open, otherwise a logger built after all others are gone truncates it
+        client_logger_builder holder_builder;
+        holder_builder.add_file_stream("shared.txt", logger::severity::critical);
+        std::unique_ptr<logger> holder(holder_builder.build());
+
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < threads_count; ++i) {
+            threads.emplace_back([] {
+                client_logger_builder builder;
+                builder.add_file_stream("shared.txt", logger::severity::information);
+                std::unique_ptr<logger> log(builder.build());
+
+                for (size_t j = 0; j < messages_count; ++j) {
+                    log->information("line");
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::ifstream in("shared.txt");
+    size_t lines = 0;
+    for (std::string line; std::getline(in, line); ++lines) {
+        EXPECT_EQ(line, "line");
+    }
+    EXPECT_EQ(lines, threads_count * messages_count);
+}
+
+#ifndef _WIN32
+TEST(client_logger_mapped, threads_append_across_regions)
+{
+    constexpr size_t threads_count = 8;
+    constexpr size_t lines_per_thread = 2000;
+
+    {
+        client_logger_builder builder;
+        builder.set_mapped_region(4096).add_file_stream("mapped.txt", logger::severity::trace);
+
+        std::unique_ptr<logger> log(builder.build());
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < threads_count; ++t) {
+            threads.emplace_back([&log, t] {
+                for (size_t i = 0; i < lines_per_thread; ++i) {
+                    log->trace("thread " + std::to_string(t) + " line " + std::to_string(i));
+                }
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::ifstream in("mapped.txt");
+    std::string line;
+    size_t lines = 0;
+    size_t bytes = 0;
+
+    while (std::getline(in, line)) {
+        ASSERT_TRUE(line.starts_with("thread ")) << line;
+        ++lines;
+        bytes += line.size() + 1;
+    }
+
+    EXPECT_EQ(lines, threads_count * lines_per_thread);
+    EXPECT_EQ(std::filesystem::file_size("mapped.txt"), bytes);
+}
+#endif
 
 int main(int argc, char *argv[])
 {
@@ -2,6 +2,12 @@
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_H
 
 #include <iostream>
+#include <concepts>
+#include <ctime>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
 
 class logger
 {
@@ -18,6 +24,98 @@ public:
         critical
     };
 
+    // Typed key/value of a structured record. Keys and string values are referenced, not copied,
+    // so a field must not outlive the log call it is passed to
+    class field
+    {
+
+    public:
+
+        enum class kind
+        {
+            SIGNED,
+            UNSIGNED,
+            FLOATING,
+            BOOLEAN,
+            POINTER,
+            STRING
+        };
+
+    private:
+
+        std::string_view _key;
+
+        kind _kind;
+
+        union
+        {
+            long long _signed;
+            unsigned long long _unsigned;
+            double _floating;
+            bool _boolean;
+            void const *_pointer;
+        };
+
+        std::string_view _string;
+
+    public:
+
+        template<std::signed_integral T>
+        field(std::string_view key, T value) noexcept : _key(key), _kind(kind::SIGNED), _signed(value) {}
+
+        template<std::unsigned_integral T>
+        requires (!std::same_as<T, bool>)
+        field(std::string_view key, T value) noexcept : _key(key), _kind(kind::UNSIGNED), _unsigned(value) {}
+
+        template<std::floating_point T>
+        field(std::string_view key, T value) noexcept : _key(key), _kind(kind::FLOATING), _floating(value) {}
+
+        field(std::string_view key, bool value) noexcept : _key(key), _kind(kind::BOOLEAN), _boolean(value) {}
+
+        field(std::string_view key, void const *value) noexcept : _key(key), _kind(kind::POINTER), _pointer(value) {}
+
+        field(std::string_view key, char const *value) noexcept : _key(key), _kind(kind::STRING), _unsigned(0),
+                                                                 _string(value) {}
+
+        field(std::string_view key, std::string_view value) noexcept : _key(key), _kind(kind::STRING), _unsigned(0),
+                                                                      _string(value) {}
+
+        field(std::string_view key, std::string const &value) noexcept : _key(key), _kind(kind::STRING),
+                                                                        _unsigned(0), _string(value) {}
+
+    public:
+
+        [[nodiscard]] std::string_view key() const noexcept
+        {
+            return _key;
+        }
+
+        [[nodiscard]] kind type() const noexcept
+        {
+            return _kind;
+        }
+
+        // value as is, e.g. 42, 0x7ffd1c, text
+        void append_text(std::string &out) const;
+
+        // value as a JSON literal, strings quoted and escaped, non-finite numbers as null
+        void append_json(std::string &out) const;
+
+    };
+
+    // Thinning of guarded call sites, applied per call site by the *_WITH_GUARD macros
+    struct sampling_policy
+    {
+        // keeps one of every `every` records, 1 keeps all
+        size_t every = 1;
+
+        // records kept per second after `every` is applied, 0 is unlimited
+        size_t per_second = 0;
+
+        // records above this severity are never dropped
+        severity max_severity = severity::debug;
+    };
+
 public:
 
     virtual ~logger() noexcept = default;
@@ -28,6 +126,24 @@ public:
         std::string const &message,
         logger::severity severity) & = 0;
 
+    // Structured record; the default renders "message key=value ..." and passes it to log(string, severity),
+    // loggers that can write fields straight into their buffers override it
+    virtual logger& log(
+        logger::severity severity,
+        std::string_view message,
+        std::span<field const> fields) &;
+
+    logger& log(
+        logger::severity severity,
+        std::string_view message,
+        std::initializer_list<field> fields) &;
+
+    // Pushes buffered records to their destinations
+    virtual logger& flush() &;
+
+    // nullptr when every guarded record is wanted
+    [[nodiscard]] virtual sampling_policy const *sampling() const noexcept;
+
 public:
 
     logger& trace(
@@ -48,6 +164,46 @@ public:
     logger& critical(
         std::string const &message) &;
 
+protected:
+
+    // Date and time of the current second, formatted once per second and per thread
+    struct timestamp
+    {
+        std::time_t second = static_cast<std::time_t>(-1);
+
+        char date_chars[10]; // dd.mm.YYYY
+
+        char time_chars[8]; // HH:MM:SS
+
+        [[nodiscard]] std::string_view date() const noexcept
+        {
+            return { date_chars, sizeof(date_chars) };
+        }
+
+        [[nodiscard]] std::string_view time() const noexcept
+        {
+            return { time_chars, sizeof(time_chars) };
+        }
+    };
+
+    static timestamp const &current_timestamp();
+
+protected:
+
+    // " key=value" for every field
+    static void append_fields_text(
+        std::string &out,
+        std::span<field const> fields);
+
+    // ,"key":value for every field
+    static void append_fields_json(
+        std::string &out,
+        std::span<field const> fields);
+
+    static void append_json_string(
+        std::string &out,
+        std::string_view value);
+
 protected:
 
     static std::string severity_to_string(
@@ -2,10 +2,114 @@
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_GUARDANT_H
 
 #include "logger.h"
+#include <atomic>
+#include <cstdint>
+
+#define LOGGER_SEVERITY_TRACE 0
+#define LOGGER_SEVERITY_DEBUG 1
+#define LOGGER_SEVERITY_INFORMATION 2
+#define LOGGER_SEVERITY_WARNING 3
+#define LOGGER_SEVERITY_ERROR 4
+#define LOGGER_SEVERITY_CRITICAL 5
+
+// Lowest severity of *_WITH_GUARD calls compiled into a translation unit, set per target, e.g.
+// target_compile_definitions(<target> PRIVATE LOGGER_MIN_SEVERITY=LOGGER_SEVERITY_INFORMATION)
+#ifndef LOGGER_MIN_SEVERITY
+#define LOGGER_MIN_SEVERITY LOGGER_SEVERITY_TRACE
+#endif
+
+#define LOGGER_COMPILED_IN(severity_name) \
+    (static_cast<int>(logger::severity::severity_name) >= LOGGER_MIN_SEVERITY)
+
+// Statement form of *_with_guard for logger_guardant members; below LOGGER_MIN_SEVERITY the whole
+// call, message construction included, is discarded at compile time. Each expansion is a call site
+// of its own for the logger's sampling policy, and a sampled out record is never constructed
+#define LOGGER_LOG_WITH_GUARD(severity_name, ...) \
+    do \
+    { \
+        if constexpr (LOGGER_COMPILED_IN(severity_name)) \
+        { \
+            static logger_guardant::call_site logger_call_site(__FILE__, __LINE__); \
+            logger *logger_target = get_logger(); \
+            if (logger_call_site.admit(logger_target, logger::severity::severity_name)) \
+            { \
+                logger_guardant::log_with_guard(logger_target, (__VA_ARGS__), logger::severity::severity_name); \
+            } \
+        } \
+    } while (false)
+
+// Structured form, the variadic part are logger::field initializers:
+// DEBUG_FIELDS_WITH_GUARD("[*] allocating", {"bytes", size}, {"block", at});
+#define LOGGER_LOG_FIELDS_WITH_GUARD(severity_name, message, ...) \
+    do \
+    { \
+        if constexpr (LOGGER_COMPILED_IN(severity_name)) \
+        { \
+            static logger_guardant::call_site logger_call_site(__FILE__, __LINE__); \
+            logger *logger_target = get_logger(); \
+            if (logger_call_site.admit(logger_target, logger::severity::severity_name)) \
+            { \
+                logger_guardant::log_with_guard(logger_target, logger::severity::severity_name, (message), \
+                                                {__VA_ARGS__}); \
+            } \
+        } \
+    } while (false)
+
+#define TRACE_WITH_GUARD(...) LOGGER_LOG_WITH_GUARD(trace, __VA_ARGS__)
+#define DEBUG_WITH_GUARD(...) LOGGER_LOG_WITH_GUARD(debug, __VA_ARGS__)
+#define INFORMATION_WITH_GUARD(...) LOGGER_LOG_WITH_GUARD(information, __VA_ARGS__)
+#define WARNING_WITH_GUARD(...) LOGGER_LOG_WITH_GUARD(warning, __VA_ARGS__)
+#define ERROR_WITH_GUARD(...) LOGGER_LOG_WITH_GUARD(error, __VA_ARGS__)
+#define CRITICAL_WITH_GUARD(...) LOGGER_LOG_WITH_GUARD(critical, __VA_ARGS__)
+
+#define TRACE_FIELDS_WITH_GUARD(message, ...) LOGGER_LOG_FIELDS_WITH_GUARD(trace, message, __VA_ARGS__)
+#define DEBUG_FIELDS_WITH_GUARD(message, ...) LOGGER_LOG_FIELDS_WITH_GUARD(debug, message, __VA_ARGS__)
+#define INFORMATION_FIELDS_WITH_GUARD(message, ...) LOGGER_LOG_FIELDS_WITH_GUARD(information, message, __VA_ARGS__)
+#define WARNING_FIELDS_WITH_GUARD(message, ...) LOGGER_LOG_FIELDS_WITH_GUARD(warning, message, __VA_ARGS__)
+#define ERROR_FIELDS_WITH_GUARD(message, ...) LOGGER_LOG_FIELDS_WITH_GUARD(error, message, __VA_ARGS__)
+#define CRITICAL_FIELDS_WITH_GUARD(message, ...) LOGGER_LOG_FIELDS_WITH_GUARD(critical, message, __VA_ARGS__)
 
 class logger_guardant
 {
 
+public:
+
+    // Sampling state of one guarded call site, shared by every object and thread passing through it
+    class call_site final
+    {
+
+    private:
+
+        char const *_file;
+
+        int _line;
+
+        std::atomic<std::uint64_t> _calls{0};
+
+        std::atomic<std::uint64_t> _suppressed{0};
+
+        std::atomic<std::int64_t> _window{-1};
+
+        std::atomic<std::uint64_t> _window_records{0};
+
+    public:
+
+        constexpr call_site(char const *file, int line) noexcept : _file(file), _line(line) {}
+
+        call_site(call_site const &) = delete;
+
+        call_site &operator=(call_site const &) = delete;
+
+    public:
+
+        // false if there is no logger or the record is sampled out; a kept record is preceded by a
+        // summary of the ones suppressed since the previous kept one
+        bool admit(
+            logger *got_logger,
+            logger::severity severity);
+
+    };
+
 public:
 
     virtual ~logger_guardant() noexcept = default;
@@ -38,6 +142,18 @@ protected:
 
     inline virtual logger *get_logger() const = 0;
 
+    // usable from const members, target of the *_WITH_GUARD macros
+    static void log_with_guard(
+        logger *got_logger,
+        std::string const &message,
+        logger::severity severity);
+
+    static void log_with_guard(
+        logger *got_logger,
+        logger::severity severity,
+        std::string_view message,
+        std::initializer_list<logger::field> fields);
+
 };
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_LOGGER_GUARDANT_H
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "../include/logger.h"
-#include <iomanip>
-#include <sstream>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
 
 logger & logger::trace(
     std::string const &message) &
@@ -38,6 +40,184 @@ logger &logger::critical(
     return log(message, logger::severity::critical);
 }
 
+logger &logger::log(
+    logger::severity severity,
+    std::string_view message,
+    std::span<field const> fields) &
+{
+    thread_local std::string buffer;
+
+    buffer.assign(message);
+    append_fields_text(buffer, fields);
+
+    return log(buffer, severity);
+}
+
+logger &logger::log(
+    logger::severity severity,
+    std::string_view message,
+    std::initializer_list<field> fields) &
+{
+    return log(severity, message, std::span<field const>(fields.begin(), fields.size()));
+}
+
+logger &logger::flush() &
+{
+    return *this;
+}
+
+logger::sampling_policy const *logger::sampling() const noexcept
+{
+    return nullptr;
+}
+
+namespace
+{
+    template<typename T>
+    void append_number(
+        std::string &out,
+        T value,
+        int base = 10)
+    {
+        char chars[32];
+        std::to_chars_result result;
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            result = std::to_chars(chars, chars + sizeof(chars), value);
+        }
+        else
+        {
+            result = std::to_chars(chars, chars + sizeof(chars), value, base);
+        }
+
+        out.append(chars, result.ptr);
+    }
+}
+
+void logger::field::append_text(
+    std::string &out) const
+{
+    switch (_kind)
+    {
+        case kind::SIGNED:
+            append_number(out, _signed);
+            break;
+        case kind::UNSIGNED:
+            append_number(out, _unsigned);
+            break;
+        case kind::FLOATING:
+            append_number(out, _floating);
+            break;
+        case kind::BOOLEAN:
+            out.append(_boolean ? "true" : "false");
+            break;
+        case kind::POINTER:
+            out.append("0x");
+            append_number(out, reinterpret_cast<std::uintptr_t>(_pointer), 16);
+            break;
+        case kind::STRING:
+            out.append(_string);
+            break;
+    }
+}
+
+void logger::field::append_json(
+    std::string &out) const
+{
+    switch (_kind)
+    {
+        case kind::FLOATING:
+            if (!std::isfinite(_floating))
+            {
+                out.append("null");
+                break;
+            }
+            append_text(out);
+            break;
+        case kind::POINTER:
+            out.push_back('"');
+            append_text(out);
+            out.push_back('"');
+            break;
+        case kind::STRING:
+            append_json_string(out, _string);
+            break;
+        default:
+            append_text(out);
+            break;
+    }
+}
+
+void logger::append_fields_text(
+    std::string &out,
+    std::span<field const> fields)
+{
+    for (auto const &item : fields)
+    {
+        out.push_back(' ');
+        out.append(item.key()).push_back('=');
+        item.append_text(out);
+    }
+}
+
+void logger::append_fields_json(
+    std::string &out,
+    std::span<field const> fields)
+{
+    for (auto const &item : fields)
+    {
+        out.push_back(',');
+        append_json_string(out, item.key());
+        out.push_back(':');
+        item.append_json(out);
+    }
+}
+
+void logger::append_json_string(
+    std::string &out,
+    std::string_view value)
+{
+    static constexpr char hex_digits[] = "0123456789abcdef";
+
+    out.push_back('"');
+
+    for (char c : value)
+    {
+        switch (c)
+        {
+            case '"':
+                out.append("\\\"");
+                break;
+            case '\\':
+                out.append("\\\\");
+                break;
+            case '\n':
+                out.append("\\n");
+                break;
+            case '\r':
+                out.append("\\r");
+                break;
+            case '\t':
+                out.append("\\t");
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    out.append("\\u00").push_back(hex_digits[c >> 4]);
+                    out.push_back(hex_digits[c & 0xf]);
+                }
+                else
+                {
+                    out.push_back(c);
+                }
+                break;
+        }
+    }
+
+    out.push_back('"');
+}
+
 std::string logger::severity_to_string(
     logger::severity severity)
 {
@@ -60,32 +240,71 @@ std::string logger::severity_to_string(
     throw std::out_of_range("Invalid severity value");
 }
 
-std::string logger::current_datetime_to_string()
+namespace
+{
+    void write_two_digits(
+        char *destination,
+        int value) noexcept
+    {
+        destination[0] = static_cast<char>('0' + value / 10 % 10);
+        destination[1] = static_cast<char>('0' + value % 10);
+    }
+}
+
+logger::timestamp const &logger::current_timestamp()
 {
+    thread_local timestamp cached;
+
     auto time = std::time(nullptr);
+    if (time == cached.second)
+    {
+        return cached;
+    }
+
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &time);
+#else
+    localtime_r(&time, &local);
+#endif
 
-    std::ostringstream result_stream;
-    result_stream << std::put_time(std::localtime(&time), "%d.%m.%Y %H:%M:%S");
+    int year = local.tm_year + 1900;
 
-    return result_stream.str();
+    write_two_digits(cached.date_chars, local.tm_mday);
+    cached.date_chars[2] = '.';
+    write_two_digits(cached.date_chars + 3, local.tm_mon + 1);
+    cached.date_chars[5] = '.';
+    write_two_digits(cached.date_chars + 6, year / 100);
+    write_two_digits(cached.date_chars + 8, year % 100);
+
+    write_two_digits(cached.time_chars, local.tm_hour);
+    cached.time_chars[2] = ':';
+    write_two_digits(cached.time_chars + 3, local.tm_min);
+    cached.time_chars[5] = ':';
+    write_two_digits(cached.time_chars + 6, local.tm_sec);
+
+    cached.second = time;
+
+    return cached;
 }
 
-std::string logger::current_date_to_string()
+std::string logger::current_datetime_to_string()
 {
-    auto time = std::time(nullptr);
+    auto const &now = current_timestamp();
 
-    std::ostringstream result_stream;
-    result_stream << std::put_time(std::localtime(&time), "%d.%m.%Y");
+    std::string result;
+    result.reserve(now.date().size() + 1 + now.time().size());
+    result.append(now.date()).append(1, ' ').append(now.time());
 
-    return result_stream.str();
+    return result;
 }
 
-std::string logger::current_time_to_string()
+std::string logger::current_date_to_string()
 {
-    auto time = std::time(nullptr);
-
-    std::ostringstream result_stream;
-    result_stream << std::put_time(std::localtime(&time), "%H:%M:%S");
+    return std::string(current_timestamp().date());
+}
 
-    return result_stream.str();
+std::string logger::current_time_to_string()
+{
+    return std::string(current_timestamp().time());
 }
@@ -1,16 +1,84 @@
 #include "../include/logger_guardant.h"
+#include <chrono>
+
+bool logger_guardant::call_site::admit(
+    logger *got_logger,
+    logger::severity severity)
+{
+    if (got_logger == nullptr)
+    {
+        return false;
+    }
+
+    auto const *policy = got_logger->sampling();
+    if (policy == nullptr || severity > policy->max_severity)
+    {
+        return true;
+    }
+
+    bool keep = policy->every <= 1 || _calls.fetch_add(1, std::memory_order_relaxed) % policy->every == 0;
+
+    if (keep && policy->per_second > 0)
+    {
+        // Budget of the current second, the first record of a new second resets it
+        std::int64_t second = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        std::int64_t window = _window.load(std::memory_order_relaxed);
+
+        if (window != second && _window.compare_exchange_strong(window, second, std::memory_order_relaxed))
+        {
+            _window_records.store(0, std::memory_order_relaxed);
+        }
+
+        keep = _window_records.fetch_add(1, std::memory_order_relaxed) < policy->per_second;
+    }
+
+    if (!keep)
+    {
+        _suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::uint64_t suppressed = _suppressed.exchange(0, std::memory_order_relaxed);
+    if (suppressed > 0)
+    {
+        got_logger->log(severity, "[sampling] suppressed records",
+                        {{"count", suppressed}, {"file", _file}, {"line", _line}});
+    }
+
+    return true;
+}
 
 logger_guardant &logger_guardant::log_with_guard(
     std::string const &message,
     logger::severity severity) &
 {
-    logger *got_logger = get_logger();
+    log_with_guard(get_logger(), message, severity);
+
+    return *this;
+}
+
+void logger_guardant::log_with_guard(
+    logger *got_logger,
+    std::string const &message,
+    logger::severity severity)
+{
     if (got_logger != nullptr)
     {
         got_logger->log(message, severity);
     }
+}
 
-    return *this;
+void logger_guardant::log_with_guard(
+    logger *got_logger,
+    logger::severity severity,
+    std::string_view message,
+    std::initializer_list<logger::field> fields)
+{
+    if (got_logger != nullptr)
+    {
+        got_logger->log(severity, message, fields);
+    }
 }
 
 logger_guardant & logger_guardant::trace_with_guard(
@@ -4,15 +4,213 @@
 #include <logger.h>
 #include <unordered_map>
 #include <httplib.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 class server_logger_builder;
 
 class server_logger final :
         public logger {
+public:
+    // Records are sent in one POST once either limit is reached, max_messages == 0 sends every record on its own
+    struct batch_policy {
+        size_t max_messages = 0;
+
+        std::chrono::milliseconds max_delay{100};
+    };
+
+    // Local storage of batched records while the server is slow or unreachable
+    struct spool_policy {
+        // records held in memory
+        size_t capacity = 4096;
+
+        // records past capacity are appended here, empty drops them instead
+        std::string overflow_path;
+
+        size_t overflow_max_bytes = 64 * 1024 * 1024;
+
+        // delay between failed sends, doubled up to max_retry_delay
+        std::chrono::milliseconds retry_delay{100};
+
+        std::chrono::milliseconds max_retry_delay{5000};
+
+        // how long destruction keeps trying to ship what is left
+        std::chrono::milliseconds shutdown_timeout{2000};
+    };
+
+    struct spool_metrics {
+        // records waiting to be shipped, in memory and in the overflow file
+        size_t depth = 0;
+
+        size_t overflow_bytes = 0;
+
+        // records lost to a full spool or to the shutdown timeout
+        size_t dropped = 0;
+
+        size_t sent = 0;
+
+        size_t failed_sends = 0;
+    };
+
+    // Destinations starting with it name a local AF_UNIX datagram socket instead of an HTTP server
+    static constexpr std::string_view unix_scheme = "unix:";
+
+    // Leads every datagram sent to a unix: destination, followed by the formatted message for log
+    // and by the file path for init
+    struct datagram_header {
+        enum class kind : std::uint8_t {
+            init,
+            log,
+            destroy
+        };
+
+        std::uint32_t pid;
+
+        kind type;
+
+        std::uint8_t severity;
+
+        std::uint8_t console;
+
+        std::uint8_t reserved;
+    };
+
+    static constexpr size_t max_datagram_size = 64 * 1024;
+
+private:
+    //region datagram_socket
+
+    // Connected unix datagram socket, every record is a single sendmsg of header and payload
+    class datagram_socket final {
+        std::string _path;
+
+        int _fd;
+
+    public:
+        // throws std::runtime_error if there is nobody listening on the path
+        explicit datagram_socket(std::string path);
+
+        datagram_socket(datagram_socket const &) = delete;
+
+        datagram_socket &operator=(datagram_socket const &) = delete;
+
+        ~datagram_socket() noexcept;
+
+        [[nodiscard]] bool send(datagram_header const &header, std::string_view payload) noexcept;
+
+        [[nodiscard]] std::string const &path() const noexcept;
+    };
+
+    //endregion datagram_socket
+
+    //region spool
+
+    // Ring of framed records plus overflow file, drained by a shipper thread over its own kept-alive
+    // connection; it also performs /init before the first batch and /destroy at the end, so the
+    // logging thread never waits on the network
+    class spool final {
+        httplib::Client _client;
+
+        batch_policy _batching;
+
+        spool_policy _policy;
+
+        int _pid;
+
+        std::vector<httplib::Params> _init_requests;
+
+        std::mutex _mutex;
+
+        std::condition_variable _ready;
+
+        std::condition_variable _drained;
+
+        std::vector<std::string> _ring;
+
+        size_t _ring_head = 0;
+
+        size_t _ring_size = 0;
+
+        std::ofstream _overflow_out;
+
+        std::ifstream _overflow_in;
+
+        size_t _overflow_records = 0;
+
+        size_t _overflow_written = 0;
+
+        size_t _overflow_shipped = 0;
+
+        std::chrono::steady_clock::time_point _first_pending;
+
+        bool _flush_requested = false;
+
+        bool _stop = false;
+
+        std::chrono::steady_clock::time_point _stop_deadline;
+
+        spool_metrics _metrics;
+
+        std::thread _worker;
+
+        void run();
+
+        [[nodiscard]] size_t depth_unlocked() const noexcept;
+
+        // oldest records first, returns their count and how much of the overflow file they take
+        size_t take_batch(std::string &body, size_t &overflow_bytes);
+
+        void commit_batch(size_t count, size_t overflow_bytes);
+
+        void reset_overflow();
+
+        // false once the shutdown deadline has passed
+        bool wait_retry(std::unique_lock<std::mutex> &lock, std::chrono::milliseconds &delay);
+
+    public:
+        spool(const std::string &host, int port, batch_policy batching, spool_policy policy, int pid,
+              std::vector<httplib::Params> init_requests);
+
+        ~spool() noexcept;
+
+        void push(logger::severity severity, std::string_view message);
+
+        // waits until the spool is empty or the next send fails
+        void flush();
+
+        [[nodiscard]] spool_metrics metrics();
+
+        [[nodiscard]] batch_policy const &batching() const noexcept;
+
+        [[nodiscard]] spool_policy const &policy() const noexcept;
+    };
+
+    //endregion spool
+
     httplib::Client _client;
 
+    std::unique_ptr<spool> _spool;
+
+    std::unique_ptr<datagram_socket> _datagram;
+
     server_logger(const std::string &dest,
-                  const std::unordered_map<logger::severity, std::pair<std::string, bool> > &streams);
+                  const std::unordered_map<logger::severity, std::pair<std::string, bool> > &streams,
+                  batch_policy batching,
+                  spool_policy spooling);
+
+    // Tells the server this pid is gone, through the spool if there is one
+    void release();
+
+    static datagram_header make_header(datagram_header::kind type, logger::severity severity, bool console = false);
+
+    static std::string format_message(const std::string &message, logger::severity severity);
 
     friend server_logger_builder;
 
@@ -33,6 +231,11 @@ public:
     [[nodiscard]] logger &log(
         const std::string &message,
         logger::severity severity) & override;
+
+    logger &flush() & override;
+
+    // zeros unless batching is enabled, batching does not apply to unix: destinations
+    [[nodiscard]] spool_metrics metrics() const;
 };
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SERVER_LOGGER_H
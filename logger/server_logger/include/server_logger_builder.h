@@ -12,6 +12,12 @@ class server_logger_builder final :
 
     std::unordered_map<logger::severity, std::pair<std::string, bool> > _output_streams;
 
+    server_logger::batch_policy _batching;
+
+    server_logger::spool_policy _spooling;
+
+    bool _spooled = false;
+
 public:
     server_logger_builder() : _destination("http://127.0.0.1:9200") {
     } // URL server destination
@@ -34,10 +40,21 @@ public:
 
     logger_builder &set_format(const std::string &format) & override;
 
+    // max_messages == 0 turns batching off
+    server_logger_builder &set_batching(size_t max_messages, std::chrono::milliseconds max_delay) &;
+
+    // log() only hands records to the spool, so without batching every record is shipped on its own
+    // (max_messages == 1) instead of blocking on the server
+    server_logger_builder &set_spool(server_logger::spool_policy policy) &;
+
     [[nodiscard]] logger *build() const override;
 
 private:
     void parse_severity(logger::severity sev, nlohmann::json& j);
+
+    void parse_batch(nlohmann::json& j);
+
+    void parse_spool(nlohmann::json& j);
 };
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SERVER_LOGGER_BUILDER_H
@@ -3,11 +3,17 @@
 #include "../include/server_logger.h"
 
 #include <server_logger_builder.h>
+#include <algorithm>
+#include <utility>
 
 #ifdef _WIN32
 #include <process.h>
 #else
+#include <sys/socket.h>
+#include <sys/un.h>
 #include <unistd.h>
+#include <cerrno>
+#include <cstring>
 #endif
 
 static void check(httplib::Result&& res)
@@ -18,34 +24,122 @@ static void check(httplib::Result&& res)
     }
 }
 
+static void check(bool sent)
+{
+    if (!sent)
+    {
+        throw std::runtime_error("datagram to server failed");
+    }
+}
+
+server_logger::datagram_header server_logger::make_header(datagram_header::kind type,
+                                                          logger::severity severity, bool console)
+{
+    return {static_cast<std::uint32_t>(inner_getpid()), type,
+            static_cast<std::uint8_t>(severity), static_cast<std::uint8_t>(console), 0};
+}
+
 server_logger::~server_logger() noexcept
 {
+    release();
+}
+
+void server_logger::release()
+{
+    if (_datagram)
+    {
+        // Best effort, a destructor has nobody to report a lost datagram to
+        (void) _datagram->send(make_header(datagram_header::kind::destroy, logger::severity::trace), {});
+        _datagram.reset();
+        return;
+    }
+
+    if (_spool)
+    {
+        // Ships whatever is still queued, then destroys
+        _spool.reset();
+        return;
+    }
+
     httplib::Params par;
     par.emplace("pid", std::to_string(server_logger::inner_getpid()));
     check(_client.Get("/destroy", par, httplib::Headers()));
 }
 
+std::string server_logger::format_message(const std::string& message,
+                                          logger::severity severity)
+{
+    auto const& now = current_timestamp();
+    std::string severity_string = severity_to_string(severity);
+
+    std::string result;
+    result.reserve(now.date().size() + now.time().size() + severity_string.size() + message.size() + 6);
+    result.append(1, '[').append(now.date()).append(1, ' ').append(now.time())
+          .append("][").append(severity_string).append("] ").append(message);
+
+    return result;
+}
+
 logger& server_logger::log(const std::string& message,
                            logger::severity severity) &
 {
-    std::stringstream stringstream;
+    if (_datagram)
+    {
+        check(_datagram->send(make_header(datagram_header::kind::log, severity),
+                              format_message(message, severity)));
+        return *this;
+    }
 
-    stringstream << "[" << current_date_to_string() << " " << current_time_to_string() <<
-        "][" << severity_to_string(severity) << "] " << message;
+    if (_spool)
+    {
+        _spool->push(severity, format_message(message, severity));
+        return *this;
+    }
 
     httplib::Params par;
     par.emplace("pid", std::to_string(server_logger::inner_getpid()));
     par.emplace("sev", severity_to_string(severity));
-    par.emplace("message", stringstream.str());
+    par.emplace("message", format_message(message, severity));
 
     check(_client.Get("/log", par, httplib::Headers()));
     return *this;
 }
 
+logger& server_logger::flush() &
+{
+    if (_spool)
+    {
+        _spool->flush();
+    }
+    return *this;
+}
+
+server_logger::spool_metrics server_logger::metrics() const
+{
+    return _spool ? _spool->metrics() : spool_metrics();
+}
+
 server_logger::server_logger(const std::string& dest,
                              const std::unordered_map<logger::severity, std::pair<std::string, bool>>&
-                             streams) : _client(dest)
+                             streams,
+                             batch_policy batching,
+                             spool_policy spooling) : _client(dest)
 {
+    if (dest.starts_with(unix_scheme))
+    {
+        _datagram = std::make_unique<datagram_socket>(dest.substr(unix_scheme.size()));
+
+        for (const auto& [fst, snd] : streams)
+        {
+            check(_datagram->send(make_header(datagram_header::kind::init, fst, snd.second), snd.first));
+        }
+        return;
+    }
+
+    _client.set_keep_alive(true);
+
+    std::vector<httplib::Params> init_requests;
+
     for (const auto& [fst, snd] : streams)
     {
         httplib::Params par;
@@ -54,6 +148,18 @@ server_logger::server_logger(const std::string& dest,
         par.emplace("path", snd.first);
         par.emplace("console", snd.second ? "1" : "0");
 
+        init_requests.push_back(std::move(par));
+    }
+
+    if (batching.max_messages > 0)
+    {
+        _spool = std::make_unique<spool>(_client.host(), _client.port(), batching, std::move(spooling),
+                                         inner_getpid(), std::move(init_requests));
+        return;
+    }
+
+    for (const auto& par : init_requests)
+    {
         check(_client.Get("/init", par, httplib::Headers()));
     }
 }
@@ -70,21 +176,47 @@ int server_logger::inner_getpid()
 server_logger::server_logger(const server_logger& other) : _client(
     httplib::Client(other._client.host(), other._client.port()))
 {
+    _client.set_keep_alive(true);
+
+    if (other._datagram)
+    {
+        _datagram = std::make_unique<datagram_socket>(other._datagram->path());
+    }
+
+    if (other._spool)
+    {
+        _spool = std::make_unique<spool>(_client.host(), _client.port(), other._spool->batching(),
+                                         other._spool->policy(), inner_getpid(), std::vector<httplib::Params>());
+    }
 }
 
 server_logger& server_logger::operator=(const server_logger& other)
 {
     if (this != &other)
     {
-        httplib::Params par;
-        par.emplace("pid", std::to_string(server_logger::inner_getpid()));
-        check(_client.Get("/destroy", par, httplib::Headers()));
+        release();
+
         _client = httplib::Client(other._client.host(), other._client.port());
+        _client.set_keep_alive(true);
+
+        if (other._datagram)
+        {
+            _datagram = std::make_unique<datagram_socket>(other._datagram->path());
+        }
+
+        if (other._spool)
+        {
+            _spool = std::make_unique<spool>(_client.host(), _client.port(), other._spool->batching(),
+                                             other._spool->policy(), inner_getpid(),
+                                             std::vector<httplib::Params>());
+        }
     }
     return *this;
 }
 
-server_logger::server_logger(server_logger&& other) noexcept : _client(std::move(other._client))
+server_logger::server_logger(server_logger&& other) noexcept : _client(std::move(other._client)),
+                                                              _spool(std::move(other._spool)),
+                                                              _datagram(std::move(other._datagram))
 {
 }
 
@@ -92,10 +224,374 @@ server_logger& server_logger::operator=(server_logger&& other) noexcept
 {
     if (this != &other)
     {
-        httplib::Params par;
-        par.emplace("pid", std::to_string(server_logger::inner_getpid()));
-        check(_client.Get("/destroy", par, httplib::Headers()));
+        release();
+
         _client = std::move(other._client);
+        _spool = std::move(other._spool);
+        _datagram = std::move(other._datagram);
     }
     return *this;
 }
+
+server_logger::datagram_socket::datagram_socket(std::string path) : _path(std::move(path)), _fd(-1)
+{
+#ifdef _WIN32
+    throw not_implemented("server_logger::datagram_socket::datagram_socket(std::string)",
+                          "unix: destinations are not supported on Windows");
+#else
+    sockaddr_un address{};
+    if (_path.size() >= sizeof(address.sun_path))
+    {
+        throw std::runtime_error("Socket path is too long: " + _path);
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, _path.c_str(), _path.size() + 1);
+
+    _fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (_fd == -1 || ::connect(_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    {
+        std::string reason = std::strerror(errno);
+        if (_fd != -1)
+        {
+            ::close(_fd);
+        }
+        throw std::runtime_error("Failed to connect to " + _path + ": " + reason);
+    }
+#endif
+}
+
+server_logger::datagram_socket::~datagram_socket() noexcept
+{
+#ifndef _WIN32
+    ::close(_fd);
+#endif
+}
+
+bool server_logger::datagram_socket::send(datagram_header const& header, std::string_view payload) noexcept
+{
+#ifdef _WIN32
+    return false;
+#else
+    if (sizeof(header) + payload.size() > max_datagram_size)
+    {
+        return false;
+    }
+
+    iovec parts[2]{{const_cast<datagram_header*>(&header), sizeof(header)},
+                   {const_cast<char*>(payload.data()), payload.size()}};
+
+    msghdr message{};
+    message.msg_iov = parts;
+    message.msg_iovlen = payload.empty() ? 1 : 2;
+
+    // Blocks while the receiver queue is full, which is the backpressure for this transport
+    ssize_t sent;
+    do
+    {
+        sent = ::sendmsg(_fd, &message, MSG_NOSIGNAL);
+    }
+    while (sent == -1 && errno == EINTR);
+
+    return sent == static_cast<ssize_t>(sizeof(header) + payload.size());
+#endif
+}
+
+std::string const& server_logger::datagram_socket::path() const noexcept
+{
+    return _path;
+}
+
+server_logger::spool::spool(const std::string& host, int port, batch_policy batching, spool_policy policy,
+                            int pid, std::vector<httplib::Params> init_requests) :
+    _client(host, port), _batching(batching), _policy(std::move(policy)), _pid(pid),
+    _init_requests(std::move(init_requests)), _ring(std::max<size_t>(_policy.capacity, 1))
+{
+    _client.set_keep_alive(true);
+
+    if (!_policy.overflow_path.empty())
+    {
+        _overflow_out.open(_policy.overflow_path, std::ios::binary | std::ios::trunc);
+        _overflow_in.open(_policy.overflow_path, std::ios::binary);
+
+        if (!_overflow_out.is_open() || !_overflow_in.is_open())
+        {
+            throw std::runtime_error("Failed to open spool overflow file: " + _policy.overflow_path);
+        }
+    }
+
+    _worker = std::thread(&spool::run, this);
+}
+
+server_logger::spool::~spool() noexcept
+{
+    {
+        std::lock_guard lock(_mutex);
+        _stop = true;
+        _stop_deadline = std::chrono::steady_clock::now() + _policy.shutdown_timeout;
+    }
+    _ready.notify_one();
+    _worker.join();
+}
+
+server_logger::batch_policy const& server_logger::spool::batching() const noexcept
+{
+    return _batching;
+}
+
+server_logger::spool_policy const& server_logger::spool::policy() const noexcept
+{
+    return _policy;
+}
+
+size_t server_logger::spool::depth_unlocked() const noexcept
+{
+    return _ring_size + _overflow_records;
+}
+
+server_logger::spool_metrics server_logger::spool::metrics()
+{
+    std::lock_guard lock(_mutex);
+
+    spool_metrics result = _metrics;
+    result.depth = depth_unlocked();
+    result.overflow_bytes = _overflow_written - _overflow_shipped;
+
+    return result;
+}
+
+void server_logger::spool::push(logger::severity severity, std::string_view message)
+{
+    std::string severity_string = severity_to_string(severity);
+    std::string length = std::to_string(message.size());
+
+    std::lock_guard lock(_mutex);
+
+    // Once records overflow, newer ones follow them to the file so that order is kept
+    if (_overflow_records == 0 && _ring_size < _ring.size())
+    {
+        // Record framing: "<SEVERITY> <length>\n<message>\n"
+        auto& slot = _ring[(_ring_head + _ring_size) % _ring.size()];
+        slot.assign(severity_string).append(1, ' ').append(length).append(1, '\n')
+            .append(message).append(1, '\n');
+        ++_ring_size;
+    }
+    else
+    {
+        size_t framed_size = severity_string.size() + length.size() + message.size() + 3;
+
+        if (!_overflow_out.is_open() || _overflow_written + framed_size > _policy.overflow_max_bytes)
+        {
+            ++_metrics.dropped;
+            return;
+        }
+
+        _overflow_out << severity_string << ' ' << length << '\n' << message << '\n';
+        _overflow_written += framed_size;
+        ++_overflow_records;
+    }
+
+    size_t depth = depth_unlocked();
+    if (depth == 1)
+    {
+        _first_pending = std::chrono::steady_clock::now();
+        _ready.notify_one();
+    }
+    else if (depth >= _batching.max_messages)
+    {
+        _ready.notify_one();
+    }
+}
+
+void server_logger::spool::flush()
+{
+    std::unique_lock lock(_mutex);
+
+    size_t failed_sends = _metrics.failed_sends;
+
+    if (depth_unlocked() > 0)
+    {
+        _flush_requested = true;
+        _ready.notify_one();
+    }
+    _drained.wait(lock, [this, failed_sends]
+    {
+        return depth_unlocked() == 0 || _metrics.failed_sends != failed_sends;
+    });
+}
+
+size_t server_logger::spool::take_batch(std::string& body, size_t& overflow_bytes)
+{
+    body.clear();
+    overflow_bytes = 0;
+
+    if (_ring_size > 0)
+    {
+        size_t count = std::min(_ring_size, std::max<size_t>(_batching.max_messages, 1));
+        for (size_t i = 0; i < count; ++i)
+        {
+            body.append(_ring[(_ring_head + i) % _ring.size()]);
+        }
+        return count;
+    }
+
+    // Ring records are all older than overflow ones, so the file is only read once the ring is empty
+    _overflow_out.flush();
+    _overflow_in.clear();
+    _overflow_in.seekg(static_cast<std::streamoff>(_overflow_shipped));
+
+    size_t count = 0;
+    std::string header;
+    while (count < std::max<size_t>(_batching.max_messages, 1) && count < _overflow_records
+           && std::getline(_overflow_in, header))
+    {
+        size_t length = std::stoul(header.substr(header.find(' ') + 1));
+        size_t offset = body.size();
+
+        body.append(header).append(1, '\n').resize(offset + header.size() + 1 + length + 1);
+        _overflow_in.read(body.data() + offset + header.size() + 1, static_cast<std::streamsize>(length + 1));
+
+        overflow_bytes += header.size() + 1 + length + 1;
+        ++count;
+    }
+
+    return count;
+}
+
+void server_logger::spool::commit_batch(size_t count, size_t overflow_bytes)
+{
+    _metrics.sent += count;
+
+    if (overflow_bytes == 0)
+    {
+        _ring_head = (_ring_head + count) % _ring.size();
+        _ring_size -= count;
+        return;
+    }
+
+    _overflow_records -= count;
+    _overflow_shipped += overflow_bytes;
+
+    if (_overflow_records == 0)
+    {
+        reset_overflow();
+    }
+}
+
+void server_logger::spool::reset_overflow()
+{
+    _overflow_out.close();
+    _overflow_out.open(_policy.overflow_path, std::ios::binary | std::ios::trunc);
+    _overflow_written = _overflow_shipped = 0;
+}
+
+bool server_logger::spool::wait_retry(std::unique_lock<std::mutex>& lock, std::chrono::milliseconds& delay)
+{
+    if (_stop && std::chrono::steady_clock::now() >= _stop_deadline)
+    {
+        return false;
+    }
+
+    _ready.wait_for(lock, delay, [this]
+    {
+        return _stop && std::chrono::steady_clock::now() >= _stop_deadline;
+    });
+    delay = std::min(delay * 2, _policy.max_retry_delay);
+
+    return !(_stop && std::chrono::steady_clock::now() >= _stop_deadline);
+}
+
+void server_logger::spool::run()
+{
+    std::unique_lock lock(_mutex);
+
+    auto delay = _policy.retry_delay;
+    bool initialized = false;
+
+    // /init has to reach the server before any record of this pid does
+    while (!initialized)
+    {
+        lock.unlock();
+        initialized = true;
+        for (const auto& par : _init_requests)
+        {
+            auto res = _client.Get("/init", par, httplib::Headers());
+            if (!res || res->status != httplib::NoContent_204)
+            {
+                initialized = false;
+                break;
+            }
+        }
+        lock.lock();
+
+        if (!initialized)
+        {
+            ++_metrics.failed_sends;
+            _drained.notify_all();
+
+            if (!wait_retry(lock, delay))
+            {
+                break;
+            }
+        }
+    }
+
+    std::string path = "/log_batch?pid=" + std::to_string(_pid);
+    std::string body;
+    delay = _policy.retry_delay;
+
+    while (initialized)
+    {
+        _ready.wait(lock, [this] { return _stop || depth_unlocked() > 0; });
+
+        if (depth_unlocked() == 0)
+        {
+            break;
+        }
+
+        _ready.wait_until(lock, _first_pending + _batching.max_delay, [this]
+        {
+            return _stop || _flush_requested || depth_unlocked() >= _batching.max_messages;
+        });
+
+        size_t overflow_bytes;
+        size_t count = take_batch(body, overflow_bytes);
+        _flush_requested = false;
+
+        lock.unlock();
+        auto res = _client.Post(path, body, "text/plain");
+        lock.lock();
+
+        if (res && res->status == httplib::NoContent_204)
+        {
+            commit_batch(count, overflow_bytes);
+            delay = _policy.retry_delay;
+            _drained.notify_all();
+            continue;
+        }
+
+        ++_metrics.failed_sends;
+        _drained.notify_all();
+
+        if (!wait_retry(lock, delay))
+        {
+            break;
+        }
+    }
+
+    // Whatever is left after the shutdown deadline is lost
+    _metrics.dropped += depth_unlocked();
+    _ring_size = _overflow_records = 0;
+    if (_overflow_out.is_open())
+    {
+        reset_overflow();
+    }
+    _drained.notify_all();
+
+    if (initialized)
+    {
+        lock.unlock();
+        httplib::Params par;
+        par.emplace("pid", std::to_string(_pid));
+        _client.Get("/destroy", par, httplib::Headers());
+    }
+}
@@ -49,8 +49,16 @@ logger_builder &server_logger_builder::transform_with_configuration(
         set_format(config["format"]);
     }
 
+    if (config.contains("batch")) {
+        parse_batch(config["batch"]);
+    }
+
+    if (config.contains("spool")) {
+        parse_spool(config["spool"]);
+    }
+
     for (auto &[key, value]: config.items()) {
-        if (key == "format") {
+        if (key == "format" || key == "batch" || key == "spool") {
             continue;
         }
         logger::severity severity = logger_builder::string_to_severity(key);
@@ -71,14 +79,54 @@ void server_logger_builder::parse_severity(logger::severity sev, nlohmann::json&
     }
 }
 
+void server_logger_builder::parse_batch(nlohmann::json& j)
+{
+    size_t max_messages = j.value("messages", size_t(0));
+    auto max_delay = std::chrono::milliseconds(j.value("interval_ms", _batching.max_delay.count()));
+    set_batching(max_messages, max_delay);
+}
+
+void server_logger_builder::parse_spool(nlohmann::json& j)
+{
+    server_logger::spool_policy policy = _spooling;
+    policy.capacity = j.value("capacity", policy.capacity);
+    policy.overflow_path = j.value("overflow_path", policy.overflow_path);
+    policy.overflow_max_bytes = j.value("overflow_max_bytes", policy.overflow_max_bytes);
+    policy.retry_delay = std::chrono::milliseconds(j.value("retry_ms", policy.retry_delay.count()));
+    policy.max_retry_delay = std::chrono::milliseconds(j.value("max_retry_ms", policy.max_retry_delay.count()));
+    policy.shutdown_timeout = std::chrono::milliseconds(j.value("shutdown_ms", policy.shutdown_timeout.count()));
+    set_spool(std::move(policy));
+}
+
 logger_builder &server_logger_builder::clear() & {
     _output_streams.clear();
     _destination = "http://127.0.0.1:9200";
+    _batching = server_logger::batch_policy();
+    _spooling = server_logger::spool_policy();
+    _spooled = false;
     return *this;
 }
 
 logger *server_logger_builder::build() const {
-    return new server_logger(_destination, _output_streams);
+    server_logger::batch_policy batching = _batching;
+    if (_spooled && batching.max_messages == 0) {
+        batching.max_messages = 1;
+    }
+
+    return new server_logger(_destination, _output_streams, batching, _spooling);
+}
+
+server_logger_builder &server_logger_builder::set_batching(size_t max_messages,
+                                                           std::chrono::milliseconds max_delay) & {
+    _batching.max_messages = max_messages;
+    _batching.max_delay = max_delay;
+    return *this;
+}
+
+server_logger_builder &server_logger_builder::set_spool(server_logger::spool_policy policy) & {
+    _spooling = std::move(policy);
+    _spooled = true;
+    return *this;
 }
 
 logger_builder &server_logger_builder::set_destination(const std::string &dest) & {
@@ -1,10 +1,57 @@
 #include "server.h"
 #include <logger_builder.h>
+#include <algorithm>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <sstream>
+#include <string_view>
 
-server::server(uint16_t port)
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace
+{
+    constexpr size_t file_buffer_size = 1 << 16;
+
+    // One fsync per file per interval covers every write made during it
+    constexpr auto sync_interval = std::chrono::seconds(1);
+
+    constexpr auto idle_timeout = std::chrono::seconds(30);
+
+    void sync_file(std::FILE* file)
+    {
+#ifdef _WIN32
+        _commit(_fileno(file));
+#else
+        fsync(fileno(file));
+#endif
+    }
+}
+
+server::server(uint16_t port, std::string unix_path, size_t writers)
 {
+    if (writers == 0)
+    {
+        writers = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    for (size_t i = 0; i < writers; ++i)
+    {
+        _writers.push_back(std::make_unique<writer>(*this));
+    }
+
+    if (!unix_path.empty())
+    {
+        _datagrams = std::make_unique<datagram_receiver>(*this, std::move(unix_path));
+    }
+
     CROW_ROUTE(app, "/init")([&](const crow::request& req)
     {
         if (req.method != crow::HTTPMethod::GET)
@@ -22,34 +69,38 @@ server::server(uint16_t port)
             << " PATH: " << path_str
             << " CONSOLE: " << console_str << std::endl;
 
-        int pid = std::stoi(pid_str);
-        logger::severity sev = logger_builder::string_to_severity(sev_str);
-        bool console = console_str == "1";
+        auto work = std::make_unique<task>();
+        work->type = task::kind::init;
+        work->pid = std::stoi(pid_str);
+        work->sev = logger_builder::string_to_severity(sev_str);
+        work->console = console_str == "1";
+        work->text = std::move(path_str);
+        dispatch(std::move(work));
 
-        std::lock_guard lock(_mut);
-        auto it = _streams.find(pid);
+        return crow::response(crow::status::NO_CONTENT);
+    });
 
-        if (it == _streams.end())
+    CROW_ROUTE(app, "/destroy")([&](const crow::request& req)
+    {
+        if (req.method != crow::HTTPMethod::GET)
         {
-            it = _streams.emplace(pid, std::unordered_map<logger::severity, std::pair<std::string, bool>>()).first;
+            return crow::response(crow::status::METHOD_NOT_ALLOWED);
         }
 
-        auto inner_it = it->second.find(sev);
+        std::string pid_str = req.url_params.get("pid");
 
-        if (inner_it == it->second.end())
-        {
-            inner_it = it->second.emplace(sev, std::make_pair(std::string(), false)).first;
-        }
+        std::cout << "DESTROY PID: " << pid_str << std::endl;
 
-        inner_it->second.first = std::move(path_str);
-        if (!inner_it->second.first.empty())
-            std::ofstream tmp(inner_it->second.first);
-        inner_it->second.second = console;
+        auto work = std::make_unique<task>();
+        work->type = task::kind::destroy;
+        work->pid = std::stoi(pid_str);
+        dispatch(std::move(work));
 
         return crow::response(crow::status::NO_CONTENT);
     });
 
-    CROW_ROUTE(app, "/destroy")([&](const crow::request& req)
+    // Records are written after the response, a file that can not be opened is reported on stderr
+    CROW_ROUTE(app, "/log")([&](const crow::request& req)
     {
         if (req.method != crow::HTTPMethod::GET)
         {
@@ -57,62 +108,507 @@ server::server(uint16_t port)
         }
 
         std::string pid_str = req.url_params.get("pid");
+        std::string sev_str = req.url_params.get("sev");
 
-        std::cout << "DESTROY PID: " << pid_str << std::endl;
+        auto work = std::make_unique<task>();
+        work->type = task::kind::log;
+        work->pid = std::stoi(pid_str);
+        work->sev = logger_builder::string_to_severity(sev_str);
+        work->text = req.url_params.get("message");
+        dispatch(std::move(work));
+
+        return crow::response(crow::status::NO_CONTENT);
+    });
+
+
+    CROW_ROUTE(app, "/log_batch").methods(crow::HTTPMethod::POST)([&](const crow::request& req)
+    {
+        const char* pid_param = req.url_params.get("pid");
+        if (pid_param == nullptr)
+        {
+            return crow::response(crow::status::BAD_REQUEST);
+        }
 
-        int pid = std::stoi(pid_str);
+        // Only validated here, the writer splits it into records
+        if (!for_each_record(req.body, [](logger::severity, std::string_view) {}))
+        {
+            return crow::response(crow::status::BAD_REQUEST);
+        }
 
-        std::lock_guard lock(_mut);
-        _streams.erase(pid);
+        auto work = std::make_unique<task>();
+        work->type = task::kind::batch;
+        work->pid = std::stoi(pid_param);
+        work->text = req.body;
+        dispatch(std::move(work));
 
         return crow::response(crow::status::NO_CONTENT);
     });
 
-    CROW_ROUTE(app, "/log")([&](const crow::request& req)
+    CROW_ROUTE(app, "/stats")([&](const crow::request&)
     {
-        if (req.method != crow::HTTPMethod::GET)
+        std::ostringstream stats;
+        auto depths = queue_depths();
+
+        for (size_t i = 0; i < depths.size(); ++i)
         {
-            return crow::response(crow::status::METHOD_NOT_ALLOWED);
+            stats << "writer " << i << " depth " << depths[i] << '\n';
         }
 
-        std::string pid_str = req.url_params.get("pid");
-        std::string sev_str = req.url_params.get("sev");
-        std::string message = req.url_params.get("message");
+        return crow::response(crow::status::OK, stats.str());
+    });
 
-        std::cout << "LOG PID: " << pid_str
-            << " SEVERITY: " << sev_str
-            << " MESSAGE: " << message << std::endl;
 
-        int pid = std::stoi(pid_str);
-        logger::severity sev = logger_builder::string_to_severity(sev_str);
+    app.port(port).loglevel(crow::LogLevel::Warning).multithreaded();
+    app.run();
+}
+
+void server::dispatch(std::unique_ptr<task> work)
+{
+    _writers[static_cast<size_t>(work->pid) % _writers.size()]->push(std::move(work));
+}
 
-        std::shared_lock lock(_mut);
-        auto it = _streams.find(pid);
+server::writer& server::owner_of(const std::string& path)
+{
+    return *_writers[std::hash<std::string>{}(path) % _writers.size()];
+}
 
-        if (it != _streams.end())
+server::~server() noexcept
+{
+    _datagrams.reset();
+
+    // Writers forward lines to each other, so none may stop before all of them ran dry
+    while (_unfinished.load(std::memory_order_acquire) != 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    _writers.clear();
+}
+
+std::vector<size_t> server::queue_depths() const
+{
+    std::vector<size_t> depths;
+    depths.reserve(_writers.size());
+
+    for (auto const& partition : _writers)
+    {
+        depths.push_back(partition->depth());
+    }
+
+    return depths;
+}
+
+template<typename F>
+bool server::for_each_record(std::string_view body, F&& f)
+{
+    // Body is a sequence of "<SEVERITY> <length>\n<message>\n" records
+    while (!body.empty())
+    {
+        size_t space = body.find(' ');
+        size_t line_end = body.find('\n', space);
+        if (space == std::string_view::npos || line_end == std::string_view::npos)
+        {
+            return false;
+        }
+
+        logger::severity sev;
+        size_t length;
+        try
         {
-            auto inner_it = it->second.find(sev);
+            sev = logger_builder::string_to_severity(std::string(body.substr(0, space)));
+            length = std::stoul(std::string(body.substr(space + 1, line_end - space - 1)));
+        }
+        catch (std::exception const&)
+        {
+            return false;
+        }
+
+        body.remove_prefix(line_end + 1);
+        if (body.size() < length + 1)
+        {
+            return false;
+        }
+
+        f(sev, body.substr(0, length));
+        body.remove_prefix(length + 1);
+    }
 
-            if (inner_it != it->second.end())
+    return true;
+}
+
+server::writer::writer(server& owner) : _server(owner), _worker(&writer::run, this)
+{
+}
+
+server::writer::~writer() noexcept
+{
+    _stop.store(true);
+    _wakeup.release();
+    _worker.join();
+}
+
+void server::writer::push(std::unique_ptr<task> work)
+{
+    _server._unfinished.fetch_add(1, std::memory_order_relaxed);
+
+    task* node = work.release();
+    task* head = _pending.load(std::memory_order_relaxed);
+
+    do
+    {
+        node->next = head;
+    }
+    while (!_pending.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+    _depth.fetch_add(1, std::memory_order_relaxed);
+
+    // Only the push that ends an empty stretch has to wake the writer up
+    if (head == nullptr)
+    {
+        _wakeup.release();
+    }
+}
+
+size_t server::writer::depth() const noexcept
+{
+    return _depth.load(std::memory_order_relaxed);
+}
+
+void server::writer::run()
+{
+    auto last_sync = std::chrono::steady_clock::now();
+
+    while (true)
+    {
+        bool stop = _stop.load();
+        task* taken = _pending.exchange(nullptr, std::memory_order_acquire);
+
+        if (taken == nullptr)
+        {
+            if (stop)
             {
-                const std::string& path = inner_it->second.first;
-                if (!path.empty())
+                break;
+            }
+
+            (void) _wakeup.try_acquire_for(sync_interval);
+        }
+
+        // The stack holds the newest task first
+        task* ordered = nullptr;
+        while (taken != nullptr)
+        {
+            task* next = taken->next;
+            taken->next = ordered;
+            ordered = taken;
+            taken = next;
+        }
+
+        while (ordered != nullptr)
+        {
+            std::unique_ptr<task> work(ordered);
+            ordered = ordered->next;
+
+            execute(*work);
+            send_outgoing();
+            _depth.fetch_sub(1, std::memory_order_relaxed);
+            _server._unfinished.fetch_sub(1, std::memory_order_release);
+        }
+
+        // Buffered lines reach the system as soon as the queue runs dry, fsync waits for the interval
+        if (_pending.load(std::memory_order_relaxed) == nullptr)
+        {
+            flush_files();
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_sync >= sync_interval)
+        {
+            sync_files(false);
+            last_sync = now;
+        }
+    }
+
+    flush_files();
+    sync_files(true);
+}
+
+void server::writer::execute(task& work)
+{
+    switch (work.type)
+    {
+        case task::kind::init:
+        {
+            auto& stream = _streams[work.pid][work.sev];
+            stream.first = std::move(work.text);
+            stream.second = work.console;
+
+            if (!stream.first.empty())
+            {
+                auto truncate = std::make_unique<task>();
+                truncate->type = task::kind::truncate;
+                truncate->path = stream.first;
+
+                writer& owner = _server.owner_of(stream.first);
+                if (&owner == this)
+                {
+                    execute(*truncate);
+                }
+                else
                 {
-                    std::ofstream stream(path, std::ios_base::app);
-                    if (stream.is_open())
-                        stream << message << std::endl;
-                    else
-                        return crow::response(crow::status::INTERNAL_SERVER_ERROR);
+                    owner.push(std::move(truncate));
                 }
-                if (inner_it->second.second)
-                    std::cout << message << std::endl;
             }
+            break;
+        }
+        case task::kind::log:
+            write_message(work.pid, work.sev, work.text);
+            break;
+        case task::kind::batch:
+            for_each_record(work.text, [this, &work](logger::severity sev, std::string_view message)
+            {
+                write_message(work.pid, sev, message);
+            });
+            break;
+        case task::kind::destroy:
+            _streams.erase(work.pid);
+            break;
+        case task::kind::truncate:
+        {
+            // Truncated, lines still buffered for it are dropped with the file
+            close_file(work.path);
+            std::ofstream tmp(work.path);
+            break;
         }
+        case task::kind::append:
+            if (auto file = file_for(work.path))
+            {
+                std::fwrite(work.text.data(), 1, work.text.size(), file->file);
+                file->unsynced = true;
+            }
+            else
+            {
+                std::cerr << "Failed to open file: " << work.path << '\n';
+            }
+            break;
+    }
+}
 
-        return crow::response(crow::status::NO_CONTENT);
-    });
+void server::writer::write_message(int pid, logger::severity sev, std::string_view message)
+{
+    auto it = _streams.find(pid);
+    if (it == _streams.end())
+    {
+        return;
+    }
 
+    auto inner_it = it->second.find(sev);
+    if (inner_it == it->second.end())
+    {
+        return;
+    }
 
-    app.port(port).loglevel(crow::LogLevel::Warning).multithreaded();
-    app.run();
+    const std::string& path = inner_it->second.first;
+    if (!path.empty())
+    {
+        if (&_server.owner_of(path) != this)
+        {
+            _outgoing[path].append(message).push_back('\n');
+        }
+        else if (auto file = file_for(path))
+        {
+            std::fwrite(message.data(), 1, message.size(), file->file);
+            std::fputc('\n', file->file);
+            file->unsynced = true;
+        }
+        else
+        {
+            std::cerr << "Failed to open file: " << path << '\n';
+        }
+    }
+
+    if (inner_it->second.second)
+    {
+        std::cout.write(message.data(), static_cast<std::streamsize>(message.size())) << '\n';
+    }
+}
+
+void server::writer::send_outgoing()
+{
+    for (auto& [path, lines] : _outgoing)
+    {
+        auto work = std::make_unique<task>();
+        work->type = task::kind::append;
+        work->path = path;
+        work->text = std::move(lines);
+        _server.owner_of(path).push(std::move(work));
+    }
+
+    _outgoing.clear();
+}
+
+server::writer::open_file* server::writer::file_for(const std::string& path)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    auto it = _files.find(path);
+    if (it == _files.end())
+    {
+        std::FILE* file = std::fopen(path.c_str(), "ab");
+        if (file == nullptr)
+        {
+            return nullptr;
+        }
+
+        std::setvbuf(file, nullptr, _IOFBF, file_buffer_size);
+        it = _files.emplace(path, open_file{file, now}).first;
+    }
+
+    it->second.last_used = now;
+    return &it->second;
+}
+
+void server::writer::close_file(const std::string& path)
+{
+    auto it = _files.find(path);
+    if (it != _files.end())
+    {
+        std::fclose(it->second.file);
+        _files.erase(it);
+    }
+}
+
+void server::writer::flush_files()
+{
+    for (auto& [path, entry] : _files)
+    {
+        std::fflush(entry.file);
+    }
+}
+
+void server::writer::sync_files(bool close_all)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    for (auto it = _files.begin(); it != _files.end();)
+    {
+        auto& entry = it->second;
+
+        if (entry.unsynced)
+        {
+            sync_file(entry.file);
+            entry.unsynced = false;
+        }
+
+        if (close_all || now - entry.last_used >= idle_timeout)
+        {
+            std::fclose(entry.file);
+            it = _files.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+server::datagram_receiver::datagram_receiver(server& owner, std::string path) : _server(owner),
+                                                                               _path(std::move(path)),
+                                                                               _fd(-1)
+{
+#ifdef _WIN32
+    throw std::runtime_error("unix: destinations are not supported on Windows");
+#else
+    sockaddr_un address{};
+    if (_path.size() >= sizeof(address.sun_path))
+    {
+        throw std::runtime_error("Socket path is too long: " + _path);
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, _path.c_str(), _path.size() + 1);
+
+    // A socket file left by a previous run would make bind fail
+    ::unlink(_path.c_str());
+
+    _fd = ::socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (_fd == -1 || ::bind(_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+    {
+        std::string reason = std::strerror(errno);
+        if (_fd != -1)
+        {
+            ::close(_fd);
+        }
+        throw std::runtime_error("Failed to bind " + _path + ": " + reason);
+    }
+
+    _worker = std::thread(&datagram_receiver::run, this);
+#endif
+}
+
+server::datagram_receiver::~datagram_receiver() noexcept
+{
+#ifndef _WIN32
+    // Wakes up the blocked recv with an end of stream
+    _stop.store(true);
+    ::shutdown(_fd, SHUT_RDWR);
+    _worker.join();
+    ::close(_fd);
+    ::unlink(_path.c_str());
+#endif
+}
+
+void server::datagram_receiver::run()
+{
+#ifndef _WIN32
+    using header = server_logger::datagram_header;
+
+    std::string buffer(server_logger::max_datagram_size, '\0');
+
+    while (true)
+    {
+        ssize_t received = ::recv(_fd, buffer.data(), buffer.size(), 0);
+        if (received <= 0 && _stop.load())
+        {
+            break;
+        }
+        if (received == -1 && errno == EINTR)
+        {
+            continue;
+        }
+        if (received == -1)
+        {
+            break;
+        }
+        // Empty datagrams are valid, and ignored like any other one too short for a header
+        if (static_cast<size_t>(received) < sizeof(header))
+        {
+            continue;
+        }
+
+        header head;
+        std::memcpy(&head, buffer.data(), sizeof(header));
+
+        auto work = std::make_unique<task>();
+        work->pid = static_cast<int>(head.pid);
+        work->sev = static_cast<logger::severity>(head.severity);
+        work->console = head.console != 0;
+        work->text.assign(buffer.data() + sizeof(header), received - sizeof(header));
+
+        switch (head.type)
+        {
+            case header::kind::init:
+                work->type = task::kind::init;
+                break;
+            case header::kind::log:
+                work->type = task::kind::log;
+                break;
+            case header::kind::destroy:
+                work->type = task::kind::destroy;
+                break;
+            default:
+                continue;
+        }
+
+        _server.dispatch(std::move(work));
+    }
+#endif
 }
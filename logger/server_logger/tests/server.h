@@ -9,26 +9,179 @@
 #include <crow.h>
 #include <unordered_map>
 #include <logger.h>
-//#include <mutex>
-#include <shared_mutex>
+#include <server_logger.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <semaphore>
+#include <string_view>
+#include <string>
+#include <vector>
 
 class server
 {
+    // Unit of work handed from request handlers to a writer
+    struct task
+    {
+        enum class kind
+        {
+            init,
+            log,
+            batch,
+            destroy,
+            truncate,
+            append
+        };
+
+        kind type;
+
+        int pid;
+
+        logger::severity sev = logger::severity::trace;
+
+        bool console = false;
+
+        // file path for init, message for log, "<SEVERITY> <length>\n<message>\n" records for batch,
+        // newline terminated lines for append
+        std::string text;
+
+        // file of truncate and append, which only its owning writer executes
+        std::string path;
+
+        task* next = nullptr;
+    };
+
+    // Thread owning the stream configuration and the open files of the pids assigned to it
+    class writer
+    {
+        server& _server;
+
+        struct open_file
+        {
+            std::FILE* file;
+
+            std::chrono::steady_clock::time_point last_used;
+
+            bool unsynced = false;
+        };
+
+        // Lock-free stack of pending tasks, taken whole and reversed by the writer thread
+        std::atomic<task*> _pending{nullptr};
+
+        std::atomic<size_t> _depth{0};
+
+        // released when _pending stops being empty
+        std::counting_semaphore<> _wakeup{0};
+
+        std::atomic<bool> _stop{false};
+
+        std::unordered_map<int, std::unordered_map<logger::severity, std::pair<std::string, bool>>> _streams;
+
+        // only files owned by this writer
+        std::unordered_map<std::string, open_file> _files;
+
+        // lines for files of other writers, sent once the current task is done
+        std::unordered_map<std::string, std::string> _outgoing;
+
+        std::thread _worker;
+
+        void run();
+
+        void execute(task& work);
+
+        void write_message(int pid, logger::severity sev, std::string_view message);
+
+        void send_outgoing();
+
+        // nullptr if the file can not be opened
+        open_file* file_for(const std::string& path);
+
+        void close_file(const std::string& path);
+
+        void flush_files();
+
+        // syncs written files and closes idle ones, or all of them
+        void sync_files(bool close_all);
+
+    public:
+
+        explicit writer(server& owner);
+
+        writer(const writer&) = delete;
+        writer& operator=(const writer&) = delete;
+
+        // executes everything already pushed
+        ~writer() noexcept;
+
+        // never blocks, safe from any thread
+        void push(std::unique_ptr<task> work);
+
+        [[nodiscard]] size_t depth() const noexcept;
+    };
+
+    // Reads framed records of unix: destinations, see server_logger::datagram_header
+    class datagram_receiver
+    {
+        server& _server;
+
+        std::string _path;
+
+        int _fd;
+
+        // set before the socket is shut down, an empty datagram alone does not end the receiver
+        std::atomic<bool> _stop{false};
+
+        std::thread _worker;
+
+        void run();
+
+    public:
+
+        // throws std::runtime_error if the socket can not be bound
+        datagram_receiver(server& owner, std::string path);
+
+        datagram_receiver(const datagram_receiver&) = delete;
+        datagram_receiver& operator=(const datagram_receiver&) = delete;
+
+        ~datagram_receiver() noexcept;
+    };
+
     crow::SimpleApp app;
 
-    std::unordered_map<int, std::unordered_map<logger::severity, std::pair<std::string, bool>>> _streams;
+    // Tasks pushed to any writer and not executed yet, writers push to each other
+    std::atomic<size_t> _unfinished{0};
+
+    // A pid always lands on the same writer, which keeps its records in order,
+    // a file is only opened by the writer its path hashes to
+    std::vector<std::unique_ptr<writer>> _writers;
+
+    // Declared last, so it stops before the writers it pushes to go away
+    std::unique_ptr<datagram_receiver> _datagrams;
 
-    std::shared_mutex _mut;
+    void dispatch(std::unique_ptr<task> work);
+
+    writer& owner_of(const std::string& path);
+
+    // Calls f(severity, message) for every record, false if the body is malformed
+    template<typename F>
+    static bool for_each_record(std::string_view body, F&& f);
 
 public:
 
-    explicit server(uint16_t port = 9200);
+    // Non-empty unix_path also accepts records of unix:<unix_path> destinations,
+    // writers == 0 starts one writer per hardware thread
+    explicit server(uint16_t port = 9200, std::string unix_path = "", size_t writers = 0);
 
     server(const server&) = delete;
     server& operator=(const server&) = delete;
     server(server&&) noexcept = delete;
     server& operator=(server&&) noexcept = delete;
-    ~server() noexcept = default;
+    // waits until the writers executed everything pushed
+    ~server() noexcept;
+
+    // Tasks pushed but not executed yet, per writer
+    [[nodiscard]] std::vector<size_t> queue_depths() const;
 };
 
 
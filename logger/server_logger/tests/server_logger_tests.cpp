@@ -14,4 +14,47 @@ int main()
 
     log->trace("IT is a very long strange message !!!!!!!!!!%%%%%%%%\tzdtjhdjh").
 		information("bfldknbpxjxjvpxvjbpzjbpsjbpsjkgbpsejegpsjpegesjpvbejpvjzepvgjs");
-}
\ No newline at end of file
+
+    builder.set_batching(64, std::chrono::milliseconds(50));
+    std::unique_ptr<logger> batched(builder.build());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        batched->trace("batched " + std::to_string(i));
+    }
+    batched->flush();
+
+    // Small ring so that most records go through the overflow file
+    server_logger::spool_policy spooling;
+    spooling.capacity = 16;
+    spooling.overflow_path = "spool.bin";
+    builder.set_spool(spooling);
+    std::unique_ptr<logger> spooled(builder.build());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        spooled->trace("spooled " + std::to_string(i));
+    }
+    spooled->flush();
+
+    // Without batching a spool still takes the records, each is shipped on its own
+    builder.set_batching(0, std::chrono::milliseconds(50));
+    std::unique_ptr<logger> unbatched(builder.build());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        unbatched->trace("unbatched " + std::to_string(i));
+    }
+    unbatched->flush();
+
+#ifndef _WIN32
+    builder.clear();
+    builder.add_file_stream("c.txt", logger::severity::trace).set_destination("unix:/tmp/mp_os_logger.sock");
+    std::unique_ptr<logger> local(builder.build());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        local->trace("datagram " + std::to_string(i));
+    }
+#endif
+}
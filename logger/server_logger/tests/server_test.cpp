@@ -5,5 +5,9 @@
 
 int main(int argc, char* argv[])
 {
+#ifdef _WIN32
     server s;
+#else
+    server s(9200, argc > 1 ? argv[1] : "/tmp/mp_os_logger.sock");
+#endif
 }
\ No newline at end of file